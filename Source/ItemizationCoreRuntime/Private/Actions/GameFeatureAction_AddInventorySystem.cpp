@@ -10,6 +10,7 @@
 #include "Inventory/InventorySystemConfiguration.h"
 #include "Inventory/InventoryDefinition.h"
 #include "Components/InventoryComponent.h"
+#include "Libraries/ItemizationInventoryLibrary.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AddInventorySystem)
 
@@ -200,4 +201,25 @@ void UGameFeatureAction_AddInventorySystem::HandleActorExtension(
 	FGameFeatureStateChangeContext ChangeContext)
 {
 	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
+
+	if (EventName != UGameFrameworkComponentManager::NAME_ExtensionAdded &&
+		EventName != UGameFrameworkComponentManager::NAME_GameActorReady)
+	{
+		return;
+	}
+
+	if (!IsValid(Actor) || !Actor->HasAuthority())
+	{
+		return;
+	}
+
+	// Bind the added inventory components to their inventory definition, so their properties apply from the start
+	for (const FItemizationGameFeatureInventoryEntry& Entry : InventoryList)
+	{
+		const UClass* ActorClass = Entry.ActorClass.Get();
+		if (ActorClass && Actor->IsA(ActorClass) && Entry.InventoryConfig)
+		{
+			UItemizationInventoryLibrary::ApplyInventoryDefinition(Actor, Entry.InventoryConfig->PlayerInventorySetup);
+		}
+	}
 }
\ No newline at end of file
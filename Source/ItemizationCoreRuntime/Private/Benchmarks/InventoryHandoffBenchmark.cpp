@@ -0,0 +1,250 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Containers/Queue.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+#include "InventoryGroupConfig.h"
+#include "Inventory/InventoryBase.h"
+#include "Items/InventoryItemInstance.h"
+#include "Items/InventoryItemSlot.h"
+#include "Items/Data/ItemComponentData_Footprint.h"
+#include "Persistence/InventoryHandoff.h"
+#include "Persistence/InventorySaveData.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace UE::ItemizationCore::Benchmarks
+{
+	/** Local stand-in for the transport between two server processes. Splits every handoff into packets and reassembles them. */
+	class FLoopbackHandoffChannel
+	{
+	public:
+		explicit FLoopbackHandoffChannel(int32 InPacketSize)
+			: PacketSize(FMath::Max(InPacketSize, 1))
+		{
+		}
+
+		void Send(TConstArrayView<uint8> Bytes)
+		{
+			for (int32 Offset = 0; Offset < Bytes.Num(); Offset += PacketSize)
+			{
+				const int32 Size = FMath::Min(PacketSize, Bytes.Num() - Offset);
+				Packets.Enqueue(TArray<uint8>(Bytes.GetData() + Offset, Size));
+			}
+		}
+
+		void Receive(TArray<uint8>& OutBytes)
+		{
+			OutBytes.Reset();
+
+			TArray<uint8> Packet;
+			while (Packets.Dequeue(Packet))
+			{
+				OutBytes.Append(Packet);
+			}
+		}
+
+	private:
+		int32 PacketSize;
+		TQueue<TArray<uint8>> Packets;
+	};
+
+	/**
+	 * Checks whether two item instances agree on every non-transient property.
+	 * Counts the properties of the source that differ from the class defaults, as only those prove the state has been handed over.
+	 */
+	static bool HasSameInstanceState(const UInventoryItemInstance* Source, const UInventoryItemInstance* Target, int32& OutNumNonDefaultProperties)
+	{
+		if (Source == nullptr || Target == nullptr)
+		{
+			return Source == Target;
+		}
+
+		if (Source->GetClass() != Target->GetClass())
+		{
+			return false;
+		}
+
+		const UObject* Defaults = Source->GetClass()->GetDefaultObject();
+		for (TFieldIterator<FProperty> It(Source->GetClass()); It; ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_Transient))
+			{
+				continue;
+			}
+
+			OutNumNonDefaultProperties += It->Identical_InContainer(Source, Defaults) ? 0 : 1;
+			if (!It->Identical_InContainer(Source, Target))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Exports the largest inventory of the world together with a slot group holding all of its items,
+	 * sends it through a loopback channel and imports it into a fresh inventory and slot group.
+	 * The first iteration verifies that every handle, every placement and the state of every item instance made it over.
+	 *
+	 * Usage: Itemization.Benchmark.Handoff [Iterations=100] [PacketSize=1200]
+	 */
+	static void RunHandoffBenchmark(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 Iterations = FMath::Max(Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 100, 1);
+		const int32 PacketSize = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 1200;
+
+		AInventoryBase* Source = nullptr;
+		for (TActorIterator<AInventoryBase> It(World); It; ++It)
+		{
+			if (It->HasAuthority() && (Source == nullptr || It->GetNumItemEntries() > Source->GetNumItemEntries()))
+			{
+				Source = *It;
+			}
+		}
+
+		if (Source == nullptr || Source->GetNumItemEntries() == 0)
+		{
+			Ar.Logf(TEXT("Inventory handoff: no authoritative inventory with items in world %s."), *GetNameSafe(World));
+			return;
+		}
+
+		FInventorySaveData SourceData;
+		FInventorySerializer::Capture(*Source, SourceData, true);
+
+		// Lay out all items of the source in a single group, with enough room that every footprint fits
+		int32 ItemArea = 0;
+		int32 MaxHeight = 1;
+		TArray<TPair<FInventoryItemHandle, FInventorySlotFootprint>> Footprints;
+		for (const FInventorySaveEntry& Entry : SourceData.Entries)
+		{
+			const FInventoryItemHandle Handle = FInventoryItemHandle::FromRaw(Entry.ItemHandle);
+			const FInventoryItemEntry* ItemEntry = Source->FindItemEntryFromHandle(Handle);
+			if (ItemEntry && ItemEntry->ItemDefinition)
+			{
+				const FInventorySlotFootprint Footprint = FItemComponentData_Footprint::GetFootprint(ItemEntry->ItemDefinition);
+				Footprints.Emplace(Handle, Footprint);
+				ItemArea += Footprint.GetArea();
+				MaxHeight = FMath::Max(MaxHeight, Footprint.Height);
+			}
+		}
+
+		FInventoryGroupConfig GroupConfig;
+		GroupConfig.NumItemColumns = FInventoryItemSlotGroup::MaxNumColumns;
+		GroupConfig.NumItemRows = FMath::Max(FMath::DivideAndRoundUp(ItemArea * 2, FInventoryItemSlotGroup::MaxNumColumns), MaxHeight);
+
+		FInventoryItemSlotGroup SourceGroup;
+		SourceGroup.Initialize(GroupConfig);
+
+		int32 NumUnplaced = 0;
+		for (const auto& Footprint : Footprints)
+		{
+			NumUnplaced += SourceGroup.PlaceItemAnywhere(Footprint.Key, Footprint.Value) ? 0 : 1;
+		}
+
+		const FInventoryItemSlotGroup* SourceGroups[] = { &SourceGroup };
+		FInventoryItemSlotGroup TargetGroup;
+
+		FLoopbackHandoffChannel Channel(PacketSize);
+		TArray<uint8> Exported;
+		TArray<uint8> Received;
+
+		double ExportSeconds = 0.0;
+		double TransferSeconds = 0.0;
+		double ImportSeconds = 0.0;
+		int32 NumFailedImports = 0;
+		int32 NumMissingHandles = 0;
+		int32 NumMismatchedPlacements = 0;
+		int32 NumMismatchedInstances = 0;
+		int32 NumNonDefaultProperties = 0;
+
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.ObjectFlags |= RF_Transient;
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			FInventoryHandoff::Export(*Source, SourceGroups, Exported);
+			ExportSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			Channel.Send(Exported);
+			Channel.Receive(Received);
+			TransferSeconds += FPlatformTime::Seconds() - StartTime;
+
+			AInventoryBase* Target = World->SpawnActor<AInventoryBase>(Source->GetClass(), SpawnInfo);
+			if (Target == nullptr)
+			{
+				++NumFailedImports;
+				continue;
+			}
+
+			TargetGroup.Initialize(GroupConfig);
+
+			StartTime = FPlatformTime::Seconds();
+			const bool bImported = FInventoryHandoff::Import(*Target, Received, [&TargetGroup](const FGameplayTag&) { return &TargetGroup; });
+			ImportSeconds += FPlatformTime::Seconds() - StartTime;
+
+			NumFailedImports += bImported ? 0 : 1;
+			if (Iteration == 0)
+			{
+				for (const FInventorySaveEntry& Entry : SourceData.Entries)
+				{
+					const FInventoryItemHandle Handle = FInventoryItemHandle::FromRaw(Entry.ItemHandle);
+					const FInventoryItemEntry* SourceEntry = Source->FindItemEntryFromHandle(Handle);
+					const FInventoryItemEntry* TargetEntry = Target->FindItemEntryFromHandle(Handle);
+					if (TargetEntry == nullptr)
+					{
+						++NumMissingHandles;
+						continue;
+					}
+
+					if (SourceEntry && !HasSameInstanceState(SourceEntry->GetItemInstance(), TargetEntry->GetItemInstance(), NumNonDefaultProperties))
+					{
+						++NumMismatchedInstances;
+					}
+				}
+
+				for (const FInventorySlotPlacement& Placement : SourceGroup.Placements)
+				{
+					const FInventorySlotPlacement* Imported = TargetGroup.FindPlacement(Placement.ItemHandle);
+					const bool bMatches = Imported && Imported->Origin == Placement.Origin && Imported->bRotated == Placement.bRotated;
+					NumMismatchedPlacements += bMatches ? 0 : 1;
+				}
+			}
+
+			Target->Destroy();
+		}
+
+		const double NumBytes = double(Exported.Num()) * Iterations;
+		Ar.Logf(TEXT("Inventory handoff: %s with %d entries, %d placed in a %ux%u slot group (%d didn't fit), %d bytes per handoff, %d iterations"),
+			*GetNameSafe(Source), Source->GetNumItemEntries(), SourceGroup.Placements.Num(), GroupConfig.NumItemRows, GroupConfig.NumItemColumns,
+			NumUnplaced, Exported.Num(), Iterations);
+		Ar.Logf(TEXT("\tExport: %.3f us, %.1f MB/s"),
+			(ExportSeconds * 1e6) / Iterations, NumBytes / FMath::Max(ExportSeconds, UE_DOUBLE_SMALL_NUMBER) / (1024.0 * 1024.0));
+		Ar.Logf(TEXT("\tLoopback transfer in %d byte packets: %.3f us"),
+			PacketSize, (TransferSeconds * 1e6) / Iterations);
+		Ar.Logf(TEXT("\tImport: %.3f us, %.1f MB/s, %d failed imports, %d handles missing and %d placements mismatched after the first import"),
+			(ImportSeconds * 1e6) / Iterations, NumBytes / FMath::Max(ImportSeconds, UE_DOUBLE_SMALL_NUMBER) / (1024.0 * 1024.0),
+			NumFailedImports, NumMissingHandles, NumMismatchedPlacements);
+		Ar.Logf(TEXT("\tInstance state: %d instances mismatched after the first import, %d non-default instance properties compared"),
+			NumMismatchedInstances, NumNonDefaultProperties);
+		if (NumNonDefaultProperties == 0)
+		{
+			Ar.Logf(ELogVerbosity::Warning, TEXT("\tNo item instance of %s has non-default properties, so the instance state check proved nothing."), *GetNameSafe(Source));
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice HandoffBenchmarkCommand(
+		TEXT("Itemization.Benchmark.Handoff"),
+		TEXT("Hands the largest inventory of the world over to a fresh inventory through a loopback channel and prints the throughput. Args: [Iterations=100] [PacketSize=1200]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunHandoffBenchmark));
+}
+
+#endif
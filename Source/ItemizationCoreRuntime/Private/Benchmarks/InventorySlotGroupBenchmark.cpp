@@ -0,0 +1,108 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/OutputDevice.h"
+
+#include "InventoryGroupConfig.h"
+#include "Items/InventoryItemSlot.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace UE::ItemizationCore::Benchmarks
+{
+	/**
+	 * Packs a number of mixed-size items into an empty slot group, first one by one with the fit search,
+	 * then repacks the whole group with AutoPack(). The default 500 items need roughly 94% of the default 10x60 grid,
+	 * the actual fill ratio is printed with the results.
+	 *
+	 * Usage: Itemization.Benchmark.SlotGroupPacking [NumItems=500] [NumRows=10] [NumColumns=60] [Iterations=100]
+	 */
+	static void RunSlotGroupPackingBenchmark(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 NumItems = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 500;
+		const int32 NumRows = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 10;
+		const int32 NumColumns = Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 60;
+		const int32 Iterations = FMath::Max(Args.IsValidIndex(3) ? FCString::Atoi(*Args[3]) : 100, 1);
+
+		FInventoryGroupConfig Config;
+		Config.NumItemRows = FMath::Max(NumRows, 1);
+		Config.NumItemColumns = FMath::Clamp(NumColumns, 1, FInventoryItemSlotGroup::MaxNumColumns);
+
+		// Mostly single cells with some two cell items, 1.125 cells per item on average, so 500 items fit into 600 cells
+		static const FInventorySlotFootprint Shapes[] =
+		{
+			FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1),
+			FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1),
+			FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1),
+			FInventorySlotFootprint(1, 1), FInventorySlotFootprint(1, 1),
+			FInventorySlotFootprint(1, 2, true),
+			FInventorySlotFootprint(2, 1, true),
+		};
+
+		FRandomStream Random(0x1743);
+		TArray<TPair<FInventoryItemHandle, FInventorySlotFootprint>> Items;
+		Items.Reserve(NumItems);
+		int32 ItemArea = 0;
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			FInventoryItemHandle Handle;
+			Handle.GenerateNewUID();
+			const FInventorySlotFootprint& Shape = Shapes[Random.RandHelper(UE_ARRAY_COUNT(Shapes))];
+			Items.Emplace(Handle, Shape);
+			ItemArea += Shape.GetArea();
+		}
+
+		const int32 NumCells = Config.NumItemRows * Config.NumItemColumns;
+		const double FillRatio = double(ItemArea) / NumCells;
+
+		double PlaceSeconds = 0.0;
+		double PackSeconds = 0.0;
+		int32 NumPlaced = 0;
+		int32 PlacedArea = 0;
+		int32 NumPackFailures = 0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FInventoryItemSlotGroup Group;
+			Group.Initialize(Config);
+
+			NumPlaced = 0;
+			PlacedArea = 0;
+			double StartTime = FPlatformTime::Seconds();
+			for (const auto& Item : Items)
+			{
+				if (Group.PlaceItemAnywhere(Item.Key, Item.Value))
+				{
+					++NumPlaced;
+					PlacedArea += Item.Value.GetArea();
+				}
+			}
+			PlaceSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			NumPackFailures += Group.AutoPack() ? 0 : 1;
+			PackSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		Ar.Logf(TEXT("Slot group packing: %d items (%d cells) into %ux%u (%d cells), fill ratio %.1f%%, %d iterations"),
+			NumItems, ItemArea, Config.NumItemRows, Config.NumItemColumns, NumCells, FillRatio * 100.0, Iterations);
+		if (FillRatio > 1.0)
+		{
+			Ar.Logf(ELogVerbosity::Warning, TEXT("\tThe items need more cells than the grid has, increase NumRows or NumColumns to time full placements."));
+		}
+		Ar.Logf(TEXT("\tPlaced %d/%d items, %.1f%% of the grid filled, %.3f us per fit search + placement"),
+			NumPlaced, NumItems, (double(PlacedArea) / NumCells) * 100.0, (PlaceSeconds * 1e6) / (double(Iterations) * FMath::Max(NumItems, 1)));
+		Ar.Logf(TEXT("\tAutoPack of the whole group: %.3f us, %d/%d repacks kept the old layout"),
+			(PackSeconds * 1e6) / Iterations, NumPackFailures, Iterations);
+	}
+
+	static FAutoConsoleCommandWithArgsAndOutputDevice SlotGroupPackingBenchmarkCommand(
+		TEXT("Itemization.Benchmark.SlotGroupPacking"),
+		TEXT("Packs mixed-size items into an inventory slot group and prints the timings. Args: [NumItems=500] [NumRows=10] [NumColumns=60] [Iterations=100]"),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&RunSlotGroupPackingBenchmark));
+}
+
+#endif
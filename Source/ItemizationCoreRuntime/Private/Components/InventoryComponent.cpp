@@ -3,9 +3,20 @@
 
 #include "Components/InventoryComponent.h"
 
+#include "ItemizationCoreSettings.h"
 #include "ItemizationLogChannels.h"
 #include "Inventory/InventoryBase.h"
-
+#include "Inventory/InventoryDefinition.h"
+#include "Items/Data/ItemComponentData_Footprint.h"
+#include "Persistence/InventoryHandoff.h"
+#include "Persistence/InventoryJournal.h"
+#include "Persistence/InventorySaveData.h"
+#include "Transactions/InventoryItemMoveOp.h"
+#include "Transactions/InventoryItemRemoveOp.h"
+
+#include "Engine/NetConnection.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "Net/UnrealNetwork.h"
 
 #if WITH_EDITOR
@@ -16,6 +27,15 @@
 
 #define LOCTEXT_NAMESPACE "InventoryComponent"
 
+namespace UE::ItemizationCore::Persistence
+{
+	/** Returns the path inside Saved/Inventories for the given save name, without extension. */
+	static FString GetSaveBasePath(const FString& SaveName)
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Inventories"), FPaths::MakeValidFileName(SaveName));
+	}
+}
+
 UInventoryComponent::UInventoryComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -161,14 +181,49 @@ void UInventoryComponent::OnInventoryCreated(AInventoryBase* Inventory)
 	if (HasAuthority())
 	{
 		InitInventoryGroups();
+		ApplyInventoryProperties(Inventory);
 	}
 
 	ITEMIZATION_N_DISPLAY("Inventory [%s] created for %s.",
 		*GetNameSafe(Inventory), *GetNameSafe(GetOwner()));
 }
 
+void UInventoryComponent::SetInventoryDefinition(const UInventoryDefinition* InInventoryDefinition, int32 InRoutingIndex)
+{
+	InventoryDefinition = InInventoryDefinition;
+	InventoryDefinitionIndex = InRoutingIndex;
+
+	if (HasAuthority())
+	{
+		if (AInventoryBase* Inventory = InventoryHandle.GetInventory())
+		{
+			ApplyInventoryProperties(Inventory);
+		}
+	}
+}
+
+void UInventoryComponent::ApplyInventoryProperties(AInventoryBase* Inventory)
+{
+	if (!IsValid(InventoryDefinition) || !IsValid(Inventory))
+	{
+		return;
+	}
+
+	if (const FInventoryPropertiesBase* Properties = InventoryDefinition->GetInventoryProperties(InventoryDefinitionIndex))
+	{
+		Inventory->SetMaxNumSlots(Properties->OverrideNumSlots);
+	}
+}
+
 void UInventoryComponent::InitInventoryGroups()
 {
+	ItemSlotGroups.Reset();
+
+	if (!IsValid(InventoryConfig))
+	{
+		return;
+	}
+	
 	for (const auto& Config : InventoryConfig->InventoryGroupConfigs)
 	{
 		// Should always be a valid group type
@@ -176,6 +231,418 @@ void UInventoryComponent::InitInventoryGroups()
 		{
 			continue;
 		}
+
+		FInventoryItemSlotGroup& Group = ItemSlotGroups.Add(Config.GroupType);
+		Group.Initialize(Config);
+	}
+}
+
+const FInventoryItemSlotGroup* UInventoryComponent::FindSlotGroup(const FGameplayTag& GroupTag) const
+{
+	return ItemSlotGroups.Find(GroupTag);
+}
+
+FInventoryItemSlotGroup* UInventoryComponent::FindSlotGroup(const FGameplayTag& GroupTag)
+{
+	return ItemSlotGroups.Find(GroupTag);
+}
+
+bool UInventoryComponent::FindFirstFreeSlot(FGameplayTag GroupTag, FInventorySlotHandle& OutSlotHandle) const
+{
+	if (const FInventoryItemSlotGroup* Group = FindSlotGroup(GroupTag))
+	{
+		return Group->FindFirstFreeSlot(OutSlotHandle);
+	}
+
+	OutSlotHandle.Reset();
+	return false;
+}
+
+bool UInventoryComponent::HasRoomInGroup(FGameplayTag GroupTag, int32 NumSlots) const
+{
+	const FInventoryItemSlotGroup* Group = FindSlotGroup(GroupTag);
+	return Group && Group->HasRoom(NumSlots);
+}
+
+bool UInventoryComponent::IsPersistent() const
+{
+	return IsValid(InventoryConfig) && InventoryConfig->bIsPersistent;
+}
+
+bool UInventoryComponent::SaveInventory(TArray<uint8>& OutData) const
+{
+	const AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr || !IsPersistent())
+	{
+		return false;
+	}
+
+	FInventorySerializer::Save(*Inventory, OutData);
+	return true;
+}
+
+bool UInventoryComponent::LoadInventory(const TArray<uint8>& Data)
+{
+	AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr || !IsPersistent() || !HasAuthority())
+	{
+		return false;
+	}
+
+	return FInventorySerializer::Load(*Inventory, Data);
+}
+
+bool UInventoryComponent::SaveInventoryAsync(const FString& SaveName, FInventorySavedDynamicDelegate OnSaved)
+{
+	const AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr || !IsPersistent() || SaveName.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString FilePath = UE::ItemizationCore::Persistence::GetSaveBasePath(SaveName) + TEXT(".inv");
+	PendingSave = FInventorySerializer::SaveAsync(*Inventory, FilePath,
+		[OnSaved](bool bSuccess)
+		{
+			OnSaved.ExecuteIfBound(bSuccess);
+		},
+		PendingSave);
+
+	return true;
+}
+
+bool UInventoryComponent::LoadInventoryFromFile(const FString& SaveName)
+{
+	AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr || !IsPersistent() || !HasAuthority() || SaveName.IsEmpty())
+	{
+		return false;
+	}
+
+	// Don't read a save that is still being written
+	PendingSave.Wait();
+
+	TArray<uint8> Data;
+	const FString FilePath = UE::ItemizationCore::Persistence::GetSaveBasePath(SaveName) + TEXT(".inv");
+	return FFileHelper::LoadFileToArray(Data, *FilePath, FILEREAD_Silent) && FInventorySerializer::Load(*Inventory, Data);
+}
+
+bool UInventoryComponent::ExportInventory(TArray<uint8>& OutData) const
+{
+	const AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr || !HasAuthority())
+	{
+		return false;
+	}
+
+	TArray<const FInventoryItemSlotGroup*, TInlineAllocator<4>> SlotGroups;
+	for (const TPair<FGameplayTag, FInventoryItemSlotGroup>& Pair : ItemSlotGroups)
+	{
+		SlotGroups.Add(&Pair.Value);
+	}
+
+	FInventoryHandoff::Export(*Inventory, SlotGroups, OutData);
+	return true;
+}
+
+bool UInventoryComponent::ImportInventory(const TArray<uint8>& Data)
+{
+	AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr || !HasAuthority())
+	{
+		return false;
+	}
+
+	return FInventoryHandoff::Import(*Inventory, Data, [this](const FGameplayTag& GroupTag)
+	{
+		return FindSlotGroup(GroupTag);
+	});
+}
+
+bool UInventoryComponent::OpenJournal(const FString& JournalName)
+{
+	AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr || !IsPersistent() || !HasAuthority() || JournalName.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString BasePath = UE::ItemizationCore::Persistence::GetSaveBasePath(JournalName);
+	TSharedPtr<FInventoryJournal> Journal = MakeShared<FInventoryJournal>(MakeUnique<FInventoryFileJournalBackend>(BasePath));
+
+	// Only attach after recovering, otherwise the replayed changes would be journaled again
+	if (!Journal->Recover(*Inventory))
+	{
+		return false;
+	}
+
+	Inventory->SetJournal(MoveTemp(Journal));
+	return true;
+}
+
+bool UInventoryComponent::FlushJournal()
+{
+	const AInventoryBase* Inventory = GetInventory();
+	FInventoryJournal* Journal = Inventory ? Inventory->GetJournal() : nullptr;
+	return Journal && Journal->Flush(*Inventory);
+}
+
+void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushRequests();
+
+	// Only tick again once new requests come in
+	SetComponentTickEnabled(false);
+}
+
+int32 UInventoryComponent::QueueRequest(const FInventoryRequest& Request)
+{
+	if (PendingRequests.Requests.Num() >= FInventoryRequestBatch::MaxNumRequests)
+	{
+		FlushRequests();
+	}
+
+	// Wake up once to send the batch at the end of the frame
+	if (PendingRequests.Requests.IsEmpty())
+	{
+		SetComponentTickEnabled(true);
+	}
+
+	return PendingRequests.Requests.Add(Request);
+}
+
+int32 UInventoryComponent::RequestRemoveItem(FInventoryItemHandle ItemHandle, int32 Delta)
+{
+	FInventoryRequest Request;
+	Request.Type = EInventoryRequestType::Remove;
+	Request.ItemHandle = ItemHandle;
+	Request.Delta = Delta;
+	return QueueRequest(Request);
+}
+
+int32 UInventoryComponent::RequestMoveItem(FInventoryItemHandle ItemHandle, AInventoryBase* TargetInventory, int32 Delta)
+{
+	FInventoryRequest Request;
+	Request.Type = EInventoryRequestType::Move;
+	Request.ItemHandle = ItemHandle;
+	Request.TargetInventory = TargetInventory;
+	Request.Delta = Delta;
+	return QueueRequest(Request);
+}
+
+int32 UInventoryComponent::RequestPlaceItem(FInventoryItemHandle ItemHandle, FGameplayTag GroupTag, FInventorySlotHandle Origin, bool bRotated)
+{
+	FInventoryRequest Request;
+	Request.Type = EInventoryRequestType::Place;
+	Request.ItemHandle = ItemHandle;
+	Request.GroupTag = GroupTag;
+	Request.SlotOrigin = Origin;
+	Request.bRotated = bRotated;
+	return QueueRequest(Request);
+}
+
+void UInventoryComponent::FlushRequests()
+{
+	if (PendingRequests.Requests.IsEmpty())
+	{
+		return;
+	}
+
+	PendingRequests.BatchId = NextRequestBatchId++;
+
+	if (GetOwner()->HasAuthority())
+	{
+		// No need to go through the network if we are the server
+		OnRequestsAcknowledgedDelegate.Broadcast(ProcessRequestBatch(PendingRequests, nullptr));
+	}
+	else
+	{
+		ServerProcessRequests(PendingRequests);
+	}
+
+	PendingRequests.Requests.Reset();
+}
+
+void UInventoryComponent::ServerProcessRequests_Implementation(const FInventoryRequestBatch& Batch)
+{
+	ClientAcknowledgeRequests(ProcessRequestBatch(Batch, GetOwner()->GetNetConnection()));
+}
+
+void UInventoryComponent::ClientAcknowledgeRequests_Implementation(const FInventoryRequestAck& Ack)
+{
+	OnRequestsAcknowledgedDelegate.Broadcast(Ack);
+}
+
+FInventoryRequestAck UInventoryComponent::ProcessRequestBatch(const FInventoryRequestBatch& Batch, UNetConnection* Connection)
+{
+	FInventoryRequestAck Ack;
+	Ack.BatchId = Batch.BatchId;
+	Ack.Results.Reserve(Batch.Requests.Num());
+
+	if (Connection == nullptr)
+	{
+		for (const FInventoryRequest& Request : Batch.Requests)
+		{
+			Ack.Results.Add(ProcessRequest(Request));
+		}
+
+		return Ack;
+	}
+
+	FInventoryRequestLimiter& Limiter = FInventoryRequestLimiter::Get();
+	const double CurrentTime = GetWorld()->GetRealTimeSeconds();
+
+	FInventoryRequestTokenBucket& ConnectionBucket = Limiter.GetConnectionBucket(Connection, CurrentTime);
+	RequestBucket.Refill(UItemizationCoreSettings::Get()->InventoryRequestBudget, CurrentTime);
+
+	int32 NumDropped = 0;
+	for (const FInventoryRequest& Request : Batch.Requests)
+	{
+		if (ConsumeRequestBudget(Request, ConnectionBucket))
+		{
+			Ack.Results.Add(ProcessRequest(Request));
+		}
+		else
+		{
+			Ack.Results.Add(EInventoryRequestResult::RateLimited);
+			++NumDropped;
+		}
+	}
+
+	if (NumDropped > 0)
+	{
+		NumDroppedRequests += NumDropped;
+
+		ITEMIZATION_S_VERBOSE("Dropped %d of %d inventory requests from %s, because the request budget was exceeded.",
+			NumDropped, Batch.Requests.Num(), *Connection->LowLevelGetRemoteAddress());
+
+		// A client spamming requests would flood the log otherwise, the counters keep the exact numbers
+		uint64 NumDroppedSinceWarning = 0;
+		if (Limiter.RecordDroppedRequests(Connection, NumDropped, CurrentTime, NumDroppedSinceWarning))
+		{
+			ITEMIZATION_S_WARN("Dropped %llu inventory requests from %s since the last warning, because the request budget was exceeded.",
+				NumDroppedSinceWarning, *Connection->LowLevelGetRemoteAddress());
+		}
+	}
+
+	return Ack;
+}
+
+bool UInventoryComponent::ConsumeRequestBudget(const FInventoryRequest& Request, FInventoryRequestTokenBucket& ConnectionBucket)
+{
+	const UItemizationCoreSettings* Settings = UItemizationCoreSettings::Get();
+	const float Cost = FInventoryRequestLimiter::GetRequestCost(Request.Type);
+
+	const bool bLimitConnection = Settings->ConnectionRequestBudget.IsEnabled();
+	const bool bLimitInventory = Settings->InventoryRequestBudget.IsEnabled();
+
+	// Only pay if both budgets can afford the request, so a dropped request doesn't drain either of them
+	if ((bLimitConnection && !ConnectionBucket.CanAfford(Cost)) ||
+		(bLimitInventory && !RequestBucket.CanAfford(Cost)))
+	{
+		return false;
+	}
+
+	if (bLimitConnection)
+	{
+		ConnectionBucket.Consume(Cost);
+	}
+
+	if (bLimitInventory)
+	{
+		RequestBucket.Consume(Cost);
+	}
+
+	return true;
+}
+
+EInventoryRequestResult UInventoryComponent::ProcessRequest(const FInventoryRequest& Request)
+{
+	AInventoryBase* Inventory = GetInventory();
+	if (Inventory == nullptr)
+	{
+		return EInventoryRequestResult::Invalid;
+	}
+
+	const FInventoryItemEntry* ItemEntry = Inventory->FindItemEntryFromHandle(Request.ItemHandle);
+	if (ItemEntry == nullptr)
+	{
+		return EInventoryRequestResult::Invalid;
+	}
+
+	switch (Request.Type)
+	{
+	case EInventoryRequestType::Remove:
+		{
+			FInventoryItemRemoveOp::Params Params;
+			Params.ItemHandle = Request.ItemHandle;
+			Params.Delta = Request.Delta;
+
+			const TInventoryTransactionResult<FInventoryItemRemoveOp> Result = FInventoryItemRemoveOp::Execute(*Inventory, Params);
+			return Result.IsOk() && (Request.Delta <= 0 || Result.GetOkValue().Missing == 0)
+				? EInventoryRequestResult::Succeeded
+				: EInventoryRequestResult::Failed;
+		}
+
+	case EInventoryRequestType::Move:
+		{
+			// Clients may only move items between inventories of the same owner
+			AInventoryBase* TargetInventory = Request.TargetInventory.Get();
+			if (TargetInventory == nullptr || TargetInventory->GetOwner() != Inventory->GetOwner())
+			{
+				return EInventoryRequestResult::Invalid;
+			}
+
+			FInventoryItemMoveOp::Params Params;
+			Params.SourceInventory = Inventory;
+			Params.TargetInventory = TargetInventory;
+			Params.ItemHandle = Request.ItemHandle;
+			Params.Delta = Request.Delta;
+
+			const TInventoryTransactionResult<FInventoryItemMoveOp> Result = FInventoryItemMoveOp::Execute(*Inventory, Params);
+			return Result.IsOk() && Result.GetOkValue().Excess == 0
+				? EInventoryRequestResult::Succeeded
+				: EInventoryRequestResult::Failed;
+		}
+
+	case EInventoryRequestType::Place:
+		{
+			FInventoryItemSlotGroup* Group = FindSlotGroup(Request.GroupTag);
+			if (Group == nullptr || !Group->IsValidSlot(Request.SlotOrigin))
+			{
+				return EInventoryRequestResult::Invalid;
+			}
+
+			const FInventorySlotFootprint Footprint = FItemComponentData_Footprint::GetFootprint(ItemEntry->ItemDefinition);
+			if (Request.bRotated && !Footprint.bCanRotate)
+			{
+				return EInventoryRequestResult::Invalid;
+			}
+
+			// Lift the item out of its current placement, so it doesn't block itself
+			TOptional<FInventorySlotPlacement> OldPlacement;
+			if (const FInventorySlotPlacement* Placement = Group->FindPlacement(Request.ItemHandle))
+			{
+				OldPlacement = *Placement;
+				Group->RemoveItem(Request.ItemHandle);
+			}
+
+			if (Group->PlaceItem(Request.ItemHandle, Request.SlotOrigin, Footprint, Request.bRotated))
+			{
+				return EInventoryRequestResult::Succeeded;
+			}
+
+			if (OldPlacement.IsSet())
+			{
+				Group->PlaceItem(OldPlacement->ItemHandle, OldPlacement->Origin, OldPlacement->Footprint, OldPlacement->bRotated);
+			}
+			return EInventoryRequestResult::Failed;
+		}
+
+	default:
+		return EInventoryRequestResult::Invalid;
 	}
 }
 
@@ -0,0 +1,193 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Debug/GameplayDebuggerCategory_Inventory.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+
+#include "Interfaces/InventoryOwnerInterface.h"
+#include "Inventory/InventoryBase.h"
+#include "Items/InventoryItemInstance.h"
+#include "Items/ItemDefinitionBase.h"
+#include "ItemizationGameplayTags.h"
+
+FGameplayDebuggerCategory_Inventory::FGameplayDebuggerCategory_Inventory()
+{
+	SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_Inventory::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_Inventory());
+}
+
+void FGameplayDebuggerCategory_Inventory::FRepData::Serialize(FArchive& Ar)
+{
+	Ar << bMetricsEnabled;
+
+	int32 NumInventories = Inventories.Num();
+	Ar << NumInventories;
+	if (Ar.IsLoading())
+	{
+		Inventories.SetNum(NumInventories);
+	}
+
+	for (FRepInventory& Inventory : Inventories)
+	{
+		Ar << Inventory.Name;
+		Ar << Inventory.NumEntries;
+		Ar << Inventory.NumInstances;
+		Ar << Inventory.NumPendingOps;
+		Ar << Inventory.OpsPerSecond;
+		Ar << Inventory.DirtyMarksPerSecond;
+		Ar << Inventory.ReplicatedBytesPerSecond;
+		Ar << Inventory.LastFrameMs;
+
+		int32 NumEntries = Inventory.Entries.Num();
+		Ar << NumEntries;
+		if (Ar.IsLoading())
+		{
+			Inventory.Entries.SetNum(NumEntries);
+		}
+
+		for (FRepEntry& Entry : Inventory.Entries)
+		{
+			Ar << Entry.Handle;
+			Ar << Entry.Definition;
+			Ar << Entry.Instance;
+			Ar << Entry.StackSize;
+			Ar << Entry.MaxStackSize;
+			Ar << Entry.bReplicatedInstance;
+			Ar << Entry.bPendingRemove;
+		}
+	}
+}
+
+void FGameplayDebuggerCategory_Inventory::GatherInventories(AActor* DebugActor, TArray<AInventoryBase*>& OutInventories)
+{
+	auto AddInventory = [&OutInventories](AInventoryBase* Inventory)
+	{
+		if (IsValid(Inventory))
+		{
+			OutInventories.AddUnique(Inventory);
+		}
+	};
+
+	if (AInventoryBase* Inventory = Cast<AInventoryBase>(DebugActor))
+	{
+		AddInventory(Inventory);
+		return;
+	}
+
+	// Inventories are usually managed by components of either the pawn or its player state
+	TArray<AActor*, TInlineAllocator<2>> Owners = { DebugActor };
+	if (const APawn* Pawn = Cast<APawn>(DebugActor))
+	{
+		Owners.Add(Pawn->GetPlayerState());
+	}
+
+	for (AActor* Owner : Owners)
+	{
+		if (Owner == nullptr)
+		{
+			continue;
+		}
+
+		if (const IInventoryOwnerInterface* InventoryOwner = Cast<IInventoryOwnerInterface>(Owner))
+		{
+			AddInventory(InventoryOwner->GetInventory());
+		}
+
+		for (const UActorComponent* Component : Owner->GetComponents())
+		{
+			if (const IInventoryOwnerInterface* InventoryOwner = Cast<IInventoryOwnerInterface>(Component))
+			{
+				AddInventory(InventoryOwner->GetInventory());
+			}
+		}
+	}
+}
+
+void FGameplayDebuggerCategory_Inventory::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	DataPack.Inventories.Reset();
+	DataPack.bMetricsEnabled = FInventoryMetrics::IsEnabled();
+
+	TArray<AInventoryBase*> Inventories;
+	GatherInventories(DebugActor, Inventories);
+
+	for (const AInventoryBase* Inventory : Inventories)
+	{
+		const FInventoryMetrics& Metrics = Inventory->GetMetrics();
+		const FInventoryMetricsWindow& Window = Metrics.GetLastWindow();
+
+		FRepInventory& RepInventory = DataPack.Inventories.AddDefaulted_GetRef();
+		RepInventory.Name = GetNameSafe(Inventory);
+		RepInventory.NumEntries = Inventory->GetNumItemEntries();
+		RepInventory.NumInstances = Inventory->GetAllItemInstances().Num();
+		RepInventory.NumPendingOps = Inventory->GetNumPendingOperations();
+		RepInventory.OpsPerSecond = Window.NumOps;
+		RepInventory.DirtyMarksPerSecond = Window.NumDirtyMarks;
+		RepInventory.ReplicatedBytesPerSecond = static_cast<uint32>((Window.NumReplicatedBits + 7) / 8);
+		RepInventory.LastFrameMs = static_cast<float>(Metrics.GetLastFrameSeconds() * 1000.0);
+
+		for (const FInventoryItemEntry& ItemEntry : Inventory->InventoryList.Items)
+		{
+			if (RepInventory.Entries.Num() >= MaxEntriesPerInventory)
+			{
+				break;
+			}
+
+			const UInventoryItemInstance* ItemInstance = ItemEntry.GetItemInstance();
+
+			FRepEntry& RepEntry = RepInventory.Entries.AddDefaulted_GetRef();
+			RepEntry.Handle = ItemEntry.ItemHandle.ToString();
+			RepEntry.Definition = GetNameSafe(ItemEntry.ItemDefinition);
+			RepEntry.Instance = ItemInstance ? ItemInstance->GetName() : FString();
+			RepEntry.StackSize = ItemEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+			RepEntry.MaxStackSize = ItemEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_MaxStackSize);
+			RepEntry.bReplicatedInstance = ItemInstance && ItemInstance->GetIsReplicated();
+			RepEntry.bPendingRemove = ItemEntry.bPendingRemove;
+		}
+	}
+}
+
+void FGameplayDebuggerCategory_Inventory::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+	if (DataPack.Inventories.IsEmpty())
+	{
+		CanvasContext.Printf(TEXT("{red}No inventories found"));
+		return;
+	}
+
+	if (!DataPack.bMetricsEnabled)
+	{
+		CanvasContext.Printf(TEXT("{yellow}Inventory metrics are disabled (Itemization.Metrics.Enabled 0)"));
+	}
+
+	for (const FRepInventory& Inventory : DataPack.Inventories)
+	{
+		CanvasContext.Printf(TEXT("{green}%s{white}  Entries: {yellow}%d{white}  Instances: {yellow}%d{white}  Pending ops: {yellow}%d"),
+			*Inventory.Name, Inventory.NumEntries, Inventory.NumInstances, Inventory.NumPendingOps);
+		CanvasContext.Printf(TEXT("\tLast frame: {yellow}%.3f ms{white}  Ops: {yellow}%u/s{white}  Dirty entries: {yellow}%u/s{white}  Replicated: {yellow}%u B/s"),
+			Inventory.LastFrameMs, Inventory.OpsPerSecond, Inventory.DirtyMarksPerSecond, Inventory.ReplicatedBytesPerSecond);
+
+		for (const FRepEntry& Entry : Inventory.Entries)
+		{
+			const TCHAR* InstanceState = Entry.Instance.IsEmpty() ? TEXT("{grey}no instance") : Entry.bReplicatedInstance ? TEXT("{white}replicated") : TEXT("{white}local");
+			CanvasContext.Printf(TEXT("\t\t%s[%s] {white}%s  {yellow}%d/%d  %s {grey}%s"),
+				Entry.bPendingRemove ? TEXT("{red}") : TEXT("{white}"),
+				*Entry.Handle, *Entry.Definition, Entry.StackSize, Entry.MaxStackSize, InstanceState, *Entry.Instance);
+		}
+
+		if (Inventory.NumEntries > Inventory.Entries.Num())
+		{
+			CanvasContext.Printf(TEXT("\t\t{grey}... %d more entries"), Inventory.NumEntries - Inventory.Entries.Num());
+		}
+	}
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
\ No newline at end of file
@@ -0,0 +1,70 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "CoreMinimal.h"
+#include "GameplayDebuggerCategory.h"
+
+class AInventoryBase;
+
+/**
+ * Gameplay debugger category showing the inventories of the debug actor together with their runtime cost.
+ * All data is collected on the authority and replicated as a data pack, so it also works against a headless dedicated server.
+ */
+class FGameplayDebuggerCategory_Inventory final : public FGameplayDebuggerCategory
+{
+public:
+	FGameplayDebuggerCategory_Inventory();
+
+	//~ Begin FGameplayDebuggerCategory Interface
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+	virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+	//~ End FGameplayDebuggerCategory Interface
+
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+protected:
+	/** Maximum number of item entries sent per inventory. */
+	static constexpr int32 MaxEntriesPerInventory = 32;
+
+	struct FRepEntry
+	{
+		FString Handle;
+		FString Definition;
+		FString Instance;
+		int32 StackSize = 0;
+		int32 MaxStackSize = 0;
+		bool bReplicatedInstance = false;
+		bool bPendingRemove = false;
+	};
+
+	struct FRepInventory
+	{
+		FString Name;
+		TArray<FRepEntry> Entries;
+		int32 NumEntries = 0;
+		int32 NumInstances = 0;
+		int32 NumPendingOps = 0;
+		uint32 OpsPerSecond = 0;
+		uint32 DirtyMarksPerSecond = 0;
+		uint32 ReplicatedBytesPerSecond = 0;
+		float LastFrameMs = 0.f;
+	};
+
+	struct FRepData
+	{
+		TArray<FRepInventory> Inventories;
+		bool bMetricsEnabled = false;
+
+		void Serialize(FArchive& Ar);
+	};
+
+	/** Collects the inventories owned by the given actor. */
+	static void GatherInventories(AActor* DebugActor, TArray<AInventoryBase*>& OutInventories);
+
+	FRepData DataPack;
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
\ No newline at end of file
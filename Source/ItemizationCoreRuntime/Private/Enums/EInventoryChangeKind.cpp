@@ -0,0 +1,4 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Enums/EInventoryChangeKind.h"
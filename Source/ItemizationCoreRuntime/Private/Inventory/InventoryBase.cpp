@@ -4,6 +4,7 @@
 #include "Inventory/InventoryBase.h"
 
 #include "Engine/ActorChannel.h"
+#include "Async/Async.h"
 #include "Net/UnrealNetwork.h"
 
 #include "Items/Data/ItemComponentData.h"
@@ -14,6 +15,7 @@
 #include "ItemizationCoreSettings.h"
 #include "ItemizationGameplayTags.h"
 #include "ItemizationLogChannels.h"
+#include "ItemizationStats.h"
 #include "Inventory/InventoryChangeMessage.h"
 #include "Transactions/InventoryTransaction_GiveRemoveItem.h"
 
@@ -44,6 +46,9 @@ AInventoryBase::AInventoryBase(const FObjectInitializer& ObjectInitializer)
 
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	// Only ticks to flush pending change sets, which should contain everything that happened this frame
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 }
 
 void AInventoryBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -61,9 +66,12 @@ void AInventoryBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLi
 
 bool AInventoryBase::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
 {
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(ReplicateSubobjects);
+
 	check(Channel);
 	check(Bunch);
 	check(RepFlags);
+	const int64 StartNumBits = Bunch->GetNumBits();
 	bool WroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
 
 	// Register the item instances
@@ -74,6 +82,8 @@ bool AInventoryBase::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunc
 			WroteSomething |= Channel->ReplicateSubobject(Instance, *Bunch, *RepFlags);
 		}
 	}
+
+	Metrics.RecordReplicatedBits(Bunch->GetNumBits() - StartNumBits);
 	
 	return WroteSomething;
 }
@@ -89,14 +99,91 @@ bool AInventoryBase::IsNetRelevantFor(
 void AInventoryBase::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
+
+	ChangeLog.SetCapacity(UItemizationCoreSettings::Get()->ChangeLogCapacity);
+}
+
+void AInventoryBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	OpCache.CancelPendingOperations();
+	PendingChangeSet.Reset();
+	DeferredItemChanges.Reset();
+	DeferredOldTotals.Reset();
+
+	ITEMIZATION_DEC_STAT_BY(NumEntries, InventoryList.Num());
+
+	if (TraitBitAddedHandle.IsValid())
+	{
+		FItemComponentData_Traits::OnTraitBitAdded().Remove(TraitBitAddedHandle);
+		TraitBitAddedHandle.Reset();
+	}
+
+	// Don't lose the changes since the last flush
+	if (Journal.IsValid())
+	{
+		Journal->Flush(*this);
+		Journal.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AInventoryBase::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	OpCache.ExecutePendingOperations(*this);
+
+	FlushChangeSet();
+
+	if (bSnapshotDirty)
+	{
+		PublishSnapshot();
+	}
+
+	// Nothing left to do until the next change or operation comes in
+	if (PendingChangeSet.IsEmpty() && !bSnapshotDirty && !OpCache.HasPendingOperations())
+	{
+		SetActorTickEnabled(false);
+	}
 }
 
 TInventoryOpHandle<FInventoryItemMoveOp> AInventoryBase::MoveItem(FInventoryItemMoveOp::Params&& Params)
 {
-	TInventoryOpRef<FInventoryItemMoveOp> Op =
-		OpCache.GetOperation<FInventoryItemMoveOp>(MoveTemp(Params));
+	if (Params.SourceInventory.IsExplicitlyNull())
+	{
+		Params.SourceInventory = this;
+	}
+
+	return EnqueueOperation<FInventoryItemMoveOp>(MoveTemp(Params));
+}
+
+TInventoryOpHandle<FInventoryItemTradeOp> AInventoryBase::TradeItems(FInventoryItemTradeOp::Params&& Params)
+{
+	if (Params.InventoryA.IsExplicitlyNull())
+	{
+		Params.InventoryA = this;
+	}
+
+	return EnqueueOperation<FInventoryItemTradeOp>(MoveTemp(Params));
+}
+
+void AInventoryBase::ExecutePendingOperations()
+{
+	OpCache.ExecutePendingOperations(*this);
+}
+
+const FInventoryItemEntry* AInventoryBase::FindItemEntryFromHandle(const FInventoryItemHandle& ItemHandle) const
+{
+	if (!ItemHandle.IsValid())
+	{
+		return nullptr;
+	}
 
-	return Op->GetHandle();
+	return InventoryList.Items.FindByPredicate([&ItemHandle](const FInventoryItemEntry& Entry)
+	{
+		return Entry.ItemHandle == ItemHandle;
+	});
 }
 
 FInventoryItemHandle AInventoryBase::GiveItem(
@@ -104,6 +191,8 @@ FInventoryItemHandle AInventoryBase::GiveItem(
 	int32& OutExcess,
 	FInventoryTransaction_GiveRemoveItem& Transaction)
 {
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(GiveItem);
+
 	check(ItemEntry.ItemDefinition);
 
 	// If locked, add to the pending list
@@ -113,13 +202,18 @@ FInventoryItemHandle AInventoryBase::GiveItem(
 	const int32 MaxStackSize = ItemEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_MaxStackSize);
 	
 
-	ITEMIZATION_N_LOG("Giving item [%s] %s\tSize: %d/%d\tSource: %s",
-		*ItemEntry.ItemHandle.ToString(),
-		*GetNameSafe(ItemEntry.ItemDefinition),
-		Transaction.Delta,
-		MaxStackSize,
-		*GetNameSafe(ItemEntry.SourceObject.Get()));
-	ItemEntry.DebugPrintStats();
+	ITEMIZATION_ITEM_LOGFMT(Verbose, "[{NetContext}] Giving item [{Item}] {Definition}\tSize: {Delta}/{MaxStackSize}\tSource: {Source}",
+		("NetContext", UE::ItemizationCore::GetNetContextString(this)),
+		("Item", ItemEntry.ItemHandle.ToString()),
+		("Definition", GetNameSafe(ItemEntry.ItemDefinition)),
+		("Delta", Transaction.Delta),
+		("MaxStackSize", MaxStackSize),
+		("Source", GetNameSafe(ItemEntry.SourceObject.Get())));
+
+	if (ITEMIZATION_ITEM_LOG_ACTIVE(VeryVerbose))
+	{
+		ItemEntry.DebugPrintStats();
+	}
 
 	return NativeGiveItem(ItemEntry, Transaction, OutExcess);
 }
@@ -145,17 +239,252 @@ bool AInventoryBase::RemoveItem(
 		Transaction.Delta = MAX_int32;
 	}
 
-	ITEMIZATION_N_LOG("Removing item [%s] \tSize: %d",
-		*ItemHandle.ToString(),
-		Transaction.Delta);
+	ITEMIZATION_ITEM_LOGFMT(Verbose, "[{NetContext}] Removing item [{Item}]\tSize: {Delta}",
+		("NetContext", UE::ItemizationCore::GetNetContextString(this)),
+		("Item", ItemHandle.ToString()),
+		("Delta", Transaction.Delta));
 
 	return NativeRemoveItem(ItemHandle, Transaction, OutMissing);
 }
 
+FInventoryItemEntry AInventoryBase::MakeTransferEntry(
+	const FInventoryItemEntry& ItemEntry,
+	int32 StackCount,
+	AInventoryBase* TargetInventory) const
+{
+	FInventoryItemEntry TransferEntry = ItemEntry;
+	TransferEntry.ClearItemInstance();
+	TransferEntry.LastObservedStackCount = 0;
+	TransferEntry.bPendingRemove = false;
+
+	// Only entire stacks can be taken over as they are
+	if (StackCount < ItemEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize))
+	{
+		TransferEntry.ItemHandle.Reset();
+	}
+
+	TransferEntry.SetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize, StackCount);
+
+	// Duplicate the instance right away, before leaving this inventory might change its state
+	const UInventoryItemInstance* Instance = ItemEntry.GetItemInstance();
+	if (TargetInventory && IsValid(Instance))
+	{
+		UInventoryItemInstance* CarriedInstance = DuplicateObject<UInventoryItemInstance>(Instance, TargetInventory);
+		if (CarriedInstance->GetIsReplicated())
+		{
+			TransferEntry.SetReplicatedItemInstance(CarriedInstance);
+		}
+		else
+		{
+			TransferEntry.SetNonReplicatedItemInstance(CarriedInstance);
+		}
+	}
+
+	return TransferEntry;
+}
+
+FInventoryItemHandle AInventoryBase::GiveTransferredItem(
+	const FInventoryItemEntry& TransferEntry,
+	int32& OutExcess,
+	FInventoryTransaction_GiveRemoveItem& Transaction)
+{
+	check(TransferEntry.ItemDefinition);
+
+	if (!TransferEntry.ItemHandle.IsValid() ||
+		FindItemEntryFromHandle(TransferEntry.ItemHandle) != nullptr ||
+		!CanCreateNewStack(TransferEntry, Transaction))
+	{
+		FInventoryItemEntry StackedEntry = TransferEntry;
+		StackedEntry.ItemHandle.Reset();
+		return GiveItem(StackedEntry, OutExcess, Transaction);
+	}
+
+	FInventoryMetrics::FScopedTimer MetricsTimer(Metrics, FInventoryMetrics::ETimer::Give);
+
+	ITEMIZATION_ITEM_LOGFMT(Verbose, "[{NetContext}] Taking over item [{Item}] {Definition}\tSize: {StackSize}",
+		("NetContext", UE::ItemizationCore::GetNetContextString(this)),
+		("Item", TransferEntry.ItemHandle.ToString()),
+		("Definition", GetNameSafe(TransferEntry.ItemDefinition)),
+		("StackSize", TransferEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize)));
+
+	FInventoryItemEntry& NewEntry = InventoryList.Items.Add_GetRef(TransferEntry);
+	UpdateTotalCount(NewEntry.ItemDefinition, NewEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize));
+	UpdateNumLimitedSlots(NewEntry.ItemDefinition, 1);
+
+	if (NewEntry.GetItemInstance())
+	{
+		AdoptItemInstance(NewEntry);
+	}
+	else if (ShouldCreateNewInstanceOfItem(NewEntry))
+	{
+		CreateNewInstanceOfItem(NewEntry);
+	}
+
+	OnGiveItem(NewEntry);
+	MarkItemEntryDirty(NewEntry, true);
+
+	OutExcess = 0;
+	return NewEntry.ItemHandle;
+}
+
+int32 AInventoryBase::SimulateExchange(
+	TConstArrayView<FInventoryItemEntry> IncomingEntries,
+	const TMap<FInventoryItemHandle, int32>& OutgoingCounts) const
+{
+	const UItemizationCoreSettings* Settings = UItemizationCoreSettings::Get();
+
+	// Stack sizes after the outgoing items left. INDEX_NONE marks entries that would be removed
+	TArray<int32, TInlineAllocator<32>> StackSizes;
+	StackSizes.Reserve(InventoryList.Items.Num());
+
+	int32 NumLimitedSlots = 0;
+	TSet<const UItemDefinitionBase*, DefaultKeyFuncs<const UItemDefinitionBase*>, TInlineSetAllocator<16>> PresentDefinitions;
+
+	for (const FInventoryItemEntry& Entry : InventoryList)
+	{
+		const int32* Outgoing = OutgoingCounts.Find(Entry.ItemHandle);
+		const int32 StackSize = Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize) - (Outgoing ? *Outgoing : 0);
+
+		if (StackSize <= 0 && !FItemComponentData_Traits::HasTrait(Entry.ItemDefinition, Settings->AllowEmptyStackTag))
+		{
+			StackSizes.Add(INDEX_NONE);
+			continue;
+		}
+
+		StackSizes.Add(FMath::Max(StackSize, 0));
+		PresentDefinitions.Add(Entry.ItemDefinition);
+
+		if (FItemComponentData_Traits::HasTrait(Entry.ItemDefinition, Settings->CountTowardsLimitTag))
+		{
+			++NumLimitedSlots;
+		}
+	}
+
+	// Stacks created by earlier incoming entries can take items of later ones
+	TArray<TPair<const UItemDefinitionBase*, int32>, TInlineAllocator<8>> NewStackRooms;
+
+	int32 TotalExcess = 0;
+	for (const FInventoryItemEntry& Incoming : IncomingEntries)
+	{
+		int32 Excess = Incoming.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+		const int32 MaxStackSize = FMath::Max(Incoming.GetStatValue(Itemization::Tags::TAG_ItemStat_MaxStackSize), 1);
+
+		const bool bSingleStack = FItemComponentData_Traits::HasTrait(Incoming.ItemDefinition, Settings->SingleStackTag);
+		const bool bCountsTowardsLimit = FItemComponentData_Traits::HasTrait(Incoming.ItemDefinition, Settings->CountTowardsLimitTag);
+
+		// Entire stacks handed over by another inventory keep a stack of their own if they can, same as GiveTransferredItem
+		if (Incoming.ItemHandle.IsValid() &&
+			!(bSingleStack && PresentDefinitions.Contains(Incoming.ItemDefinition)) &&
+			!(bCountsTowardsLimit && MaxNumSlots >= 0 && NumLimitedSlots >= MaxNumSlots))
+		{
+			PresentDefinitions.Add(Incoming.ItemDefinition);
+			NumLimitedSlots += bCountsTowardsLimit ? 1 : 0;
+
+			if (MaxStackSize > Excess)
+			{
+				NewStackRooms.Emplace(Incoming.ItemDefinition, MaxStackSize - Excess);
+			}
+			continue;
+		}
+
+		// Fill up existing stacks first, same as NativeGiveItem
+		if (MaxStackSize > 1)
+		{
+			for (int32 Idx = 0; Idx < InventoryList.Items.Num() && Excess > 0; ++Idx)
+			{
+				const FInventoryItemEntry& Entry = InventoryList.Items[Idx];
+				if (StackSizes[Idx] == INDEX_NONE || StackSizes[Idx] >= MaxStackSize ||
+					Entry.ItemDefinition != Incoming.ItemDefinition || !CanMergeItems(Incoming, Entry))
+				{
+					continue;
+				}
+
+				const int32 Delta = FMath::Min(Excess, MaxStackSize - StackSizes[Idx]);
+				StackSizes[Idx] += Delta;
+				Excess -= Delta;
+			}
+
+			for (TPair<const UItemDefinitionBase*, int32>& NewStack : NewStackRooms)
+			{
+				if (Excess > 0 && NewStack.Key == Incoming.ItemDefinition)
+				{
+					const int32 Delta = FMath::Min(Excess, NewStack.Value);
+					NewStack.Value -= Delta;
+					Excess -= Delta;
+				}
+			}
+		}
+
+		// Then create new stacks, same restrictions as CanCreateNewStack
+		while (Excess > 0)
+		{
+			if (bSingleStack && PresentDefinitions.Contains(Incoming.ItemDefinition))
+			{
+				break;
+			}
+
+			if (bCountsTowardsLimit && MaxNumSlots >= 0 && NumLimitedSlots >= MaxNumSlots)
+			{
+				break;
+			}
+
+			const int32 DeltaStack = FMath::Min(Excess, MaxStackSize);
+			Excess -= DeltaStack;
+
+			PresentDefinitions.Add(Incoming.ItemDefinition);
+			NumLimitedSlots += bCountsTowardsLimit ? 1 : 0;
+
+			if (MaxStackSize > DeltaStack)
+			{
+				NewStackRooms.Emplace(Incoming.ItemDefinition, MaxStackSize - DeltaStack);
+			}
+		}
+
+		TotalExcess += Excess;
+	}
+
+	return TotalExcess;
+}
+
+void AInventoryBase::BeginDeferredNotifications()
+{
+	++DeferredNotificationDepth;
+}
+
+void AInventoryBase::EndDeferredNotifications()
+{
+	check(DeferredNotificationDepth > 0);
+	if (--DeferredNotificationDepth > 0)
+	{
+		return;
+	}
+
+	// Listeners might change the inventory again, so work on local copies
+	TArray<FDeferredItemChange> ItemChanges = MoveTemp(DeferredItemChanges);
+	TMap<TObjectKey<UItemDefinitionBase>, int32> OldTotals = MoveTemp(DeferredOldTotals);
+
+	for (const FDeferredItemChange& Change : ItemChanges)
+	{
+		RecordItemChange(Change.ItemEntry, Change.LastCount, Change.NewCount, Change.Kind);
+	}
+
+	for (const TPair<TObjectKey<UItemDefinitionBase>, int32>& Pair : OldTotals)
+	{
+		const UItemDefinitionBase* ItemDefinition = Pair.Key.ResolveObjectPtr();
+		const int32 NewTotal = GetTotalCount(ItemDefinition);
+		if (ItemDefinition && NewTotal != Pair.Value)
+		{
+			OnTotalCountChangedDelegate.Broadcast(ItemDefinition, NewTotal, Pair.Value);
+		}
+	}
+}
+
 void AInventoryBase::EvaluateItemEntry(
 	const FInventoryItemEntry& ItemEntry,
 	FInventoryTransaction_GiveRemoveItem& InOutTransaction)
 {
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(EvaluateItemEntry);
+
 	if (!ensure(ItemEntry.ItemDefinition))
 	{
 		return;
@@ -179,6 +508,9 @@ FInventoryItemHandle AInventoryBase::NativeGiveItem(
 	FInventoryTransaction_GiveRemoveItem& Transaction,
 	int32& OutExcess)
 {
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(NativeGiveItem);
+	FInventoryMetrics::FScopedTimer MetricsTimer(Metrics, FInventoryMetrics::ETimer::Give);
+
 	OutExcess = Transaction.Delta;
 
 	FInventoryItemHandle LastHandle;
@@ -189,28 +521,46 @@ FInventoryItemHandle AInventoryBase::NativeGiveItem(
 	// Try to fill up existing stacks first, before creating new ones
 	if (MaxStackSize > 1)
 	{
+		// Working copy that only carries the stack size that is still left to merge
+		FInventoryItemEntry PendingEntry = ItemEntry;
+
 		for (FInventoryItemEntry& FoundEntry : InventoryList)
 		{
+			// Nothing left to merge
+			if (OutExcess <= 0)
+			{
+				break;
+			}
+
 			// Only consider items of the same type
 			if (FoundEntry.ItemDefinition != ItemEntry.ItemDefinition)
 			{
 				continue;
 			}
 
-			const int32 OldStackSize = ItemEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
-			if (CanMergeItems(ItemEntry, FoundEntry))
+			// Skip stacks that are already full
+			const int32 OldStackSize = FoundEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+			if (OldStackSize >= MaxStackSize)
+			{
+				continue;
+			}
+
+			PendingEntry.SetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize, OutExcess);
+			if (CanMergeItems(PendingEntry, FoundEntry))
 			{
 				// Merge the items
 				int32 MergeExcess;
-				MergeItems(ItemEntry, FoundEntry, MergeExcess);
+				MergeItems(PendingEntry, FoundEntry, MergeExcess);
 
 				// Update the delta excess of what is left after the merge
 				OutExcess = FMath::Max(0, MergeExcess);
 				LastHandle = FoundEntry.ItemHandle;
 
+				const int32 NewStackSize = FoundEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+				UpdateTotalCount(FoundEntry.ItemDefinition, NewStackSize - OldStackSize);
+
 				// Broadcast the change event
-				NotifyItemChanged(FoundEntry, OldStackSize,
-					FoundEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize));
+				NotifyItemChanged(FoundEntry, OldStackSize, NewStackSize);
 
 				// Mark the item dirty for replication
 				MarkItemEntryDirty(FoundEntry, true);
@@ -218,6 +568,9 @@ FInventoryItemHandle AInventoryBase::NativeGiveItem(
 		}
 	}
 
+	// An instance carried over from another inventory goes to the first new stack
+	bool bCarriedInstanceTaken = ItemEntry.GetItemInstance() == nullptr;
+
 	// If we have excess items, try to add them to the new inventory
 	while (OutExcess > 0)
 	{
@@ -239,11 +592,23 @@ FInventoryItemHandle AInventoryBase::NativeGiveItem(
 		NewEntry.ItemHandle.GenerateNewUID();
 
 		LastHandle = NewEntry.ItemHandle;
+		UpdateTotalCount(NewEntry.ItemDefinition, DeltaStack);
+		UpdateNumLimitedSlots(NewEntry.ItemDefinition, 1);
 
-		// Create a mew instance server-side
-		if (ShouldCreateNewInstanceOfItem(NewEntry))
+		if (!bCarriedInstanceTaken)
 		{
-			CreateNewInstanceOfItem(NewEntry);
+			bCarriedInstanceTaken = true;
+			AdoptItemInstance(NewEntry);
+		}
+		else
+		{
+			NewEntry.ClearItemInstance();
+
+			// Create a mew instance server-side
+			if (ShouldCreateNewInstanceOfItem(NewEntry))
+			{
+				CreateNewInstanceOfItem(NewEntry);
+			}
 		}
 
 		// Initialize
@@ -263,6 +628,9 @@ bool AInventoryBase::NativeRemoveItem(
 	int32& OutMissing,
 	bool bRecursive)
 {
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(NativeRemoveItem);
+	FInventoryMetrics::FScopedTimer MetricsTimer(Metrics, FInventoryMetrics::ETimer::Remove);
+
 	// Clear out pending items that are waiting to be added
 
 	// Mutable count for tracking
@@ -282,8 +650,8 @@ bool AInventoryBase::NativeRemoveItem(
 
 		if (Entry != Operator && Entry.ItemHandle != Operator)
 		{
-			ITEMIZATION_LOG("Item Entry [%s] does not match the operator.",
-				*Entry.GetDebugString());
+			ITEMIZATION_ITEM_LOGFMT(VeryVerbose, "Item entry [{Entry}] does not match the operator.",
+				("Entry", Entry.GetDebugString()));
 			continue;
 		}
 
@@ -294,24 +662,32 @@ bool AInventoryBase::NativeRemoveItem(
 		// Get the actual stack size we can remove
 		const int32 StackSize = Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
 		const int32 Delta = FMath::Min(DesiredRemoveCount,StackSize);
+		const int32 NewStackSize = StackSize - Delta;
 		
-		Entry.SetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize, StackSize - Delta);
+		Entry.SetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize, NewStackSize);
 		DesiredRemoveCount -= Delta;
+		UpdateTotalCount(Entry.ItemDefinition, -Delta);
 
 		bDidRemoveAtLeastOne = true;
 
-		// Mark dirty for replication
-		MarkItemEntryDirty(Entry, true);
+		// If the entry still has items left or may keep an empty stack, it has only changed
+		if (NewStackSize > 0 ||
+			FItemComponentData_Traits::HasTrait(Entry.ItemDefinition, UItemizationCoreSettings::Get()->AllowEmptyStackTag))
+		{
+			NotifyItemChanged(Entry, StackSize, NewStackSize);
 
-		// If the entry now has an empty stack, remove it.
-		if ((Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize) <= 0) &&
-			!FItemComponentData_Traits::HasTrait(Entry.ItemDefinition, UItemizationCoreSettings::Get()->AllowEmptyStackTag))
+			// Mark dirty for replication
+			MarkItemEntryDirty(Entry, true);
+		}
+		else
 		{
 			// Perform a scope lock
 
 
-			// Notify the item about its removal
+			// Notify the item about its removal, the payload reports the count it had before
+			Entry.LastObservedStackCount = StackSize;
 			OnRemoveItem(Entry);
+			UpdateNumLimitedSlots(Entry.ItemDefinition, -1);
 
 			// Remove the item entry and mark it dirty for replication
 			It.RemoveCurrent();
@@ -388,10 +764,31 @@ bool AInventoryBase::CanCreateNewStack(
 	{
 		return InventoryList.Items.Contains(ItemEntry.ItemDefinition) == false;
 	}
+
+	// Respect the inventory limit for items that count towards it
+	if (MaxNumSlots >= 0 &&
+		FItemComponentData_Traits::HasTrait(ItemEntry.ItemDefinition, UItemizationCoreSettings::Get()->CountTowardsLimitTag))
+	{
+		return GetNumLimitedSlots() < MaxNumSlots;
+	}
 	
 	return true;
 }
 
+void AInventoryBase::SetMaxNumSlots(int32 InMaxNumSlots)
+{
+	MaxNumSlots = InMaxNumSlots < 0 ? INDEX_NONE : InMaxNumSlots;
+}
+
+void AInventoryBase::UpdateNumLimitedSlots(const UItemDefinitionBase* ItemDefinition, int32 Delta)
+{
+	if (Delta != 0 && ItemDefinition != nullptr &&
+		FItemComponentData_Traits::HasTrait(ItemDefinition, UItemizationCoreSettings::Get()->CountTowardsLimitTag))
+	{
+		NumLimitedSlots = FMath::Max(0, NumLimitedSlots + Delta);
+	}
+}
+
 bool AInventoryBase::ShouldCreateNewInstanceOfItem(const FInventoryItemEntry& ItemEntry) const
 {
 	return ItemEntry.ItemDefinition->bWantsItemInstance;
@@ -399,6 +796,8 @@ bool AInventoryBase::ShouldCreateNewInstanceOfItem(const FInventoryItemEntry& It
 
 UInventoryItemInstance* AInventoryBase::CreateNewInstanceOfItem(FInventoryItemEntry& ItemEntry)
 {
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(CreateNewInstanceOfItem);
+
 	checkf(ItemEntry.GetItemInstance() == nullptr, TEXT("Item instance already exists for item [%s]!"),
 		*ItemEntry.GetDebugString());
 
@@ -427,7 +826,8 @@ UInventoryItemInstance* AInventoryBase::CreateNewInstanceOfItem(FInventoryItemEn
 		ItemEntry.SetNonReplicatedItemInstance(NewInstance);
 	}
 
-	ITEMIZATION_ERROR("Created a new item instance %s", *GetNameSafe(NewInstance));
+	ITEMIZATION_ITEM_LOGFMT(Verbose, "Created a new item instance {Instance}",
+		("Instance", GetNameSafe(NewInstance)));
 
 	return NewInstance;
 }
@@ -477,12 +877,7 @@ void AInventoryBase::NotifyItemAdded(
 	const int32& LastCount,
 	const int32& NewCount)
 {
-	FInventoryChangeMessage Payload(&ItemEntry, LastCount, NewCount);
-	Payload.Controller = GetInstigatorController();
-	Payload.Owner = GetOwner();
-	Payload.SourceInventory = Payload.TargetInventory = this;
-
-	OnItemAddedDelegate.Broadcast(Payload);
+	RecordItemChange(ItemEntry, FMath::Max(LastCount, 0), NewCount, EInventoryChangeKind::Added);
 }
 
 void AInventoryBase::NotifyItemRemoved(
@@ -490,12 +885,7 @@ void AInventoryBase::NotifyItemRemoved(
 	const int32& LastCount,
 	const int32& NewCount)
 {
-	FInventoryChangeMessage Payload(&ItemEntry, LastCount, NewCount);
-	Payload.Controller = GetInstigatorController();
-	Payload.Owner = GetOwner();
-	Payload.SourceInventory = Payload.TargetInventory = this;
-
-	OnItemAddedDelegate.Broadcast(Payload);
+	RecordItemChange(ItemEntry, FMath::Max(LastCount, 0), NewCount, EInventoryChangeKind::Removed);
 }
 
 void AInventoryBase::NotifyItemChanged(
@@ -503,17 +893,237 @@ void AInventoryBase::NotifyItemChanged(
 	const int32& LastCount,
 	const int32& NewCount)
 {
-	FInventoryChangeMessage Payload(&ItemEntry, LastCount, NewCount);
-	Payload.Controller = GetInstigatorController();
-	Payload.Owner = GetOwner();
-	Payload.SourceInventory = Payload.TargetInventory = this;
+	RecordItemChange(ItemEntry, FMath::Max(LastCount, 0), NewCount, EInventoryChangeKind::Changed);
+}
+
+void AInventoryBase::RecordItemChange(
+	const FInventoryItemEntry& ItemEntry,
+	int32 LastCount,
+	int32 NewCount,
+	EInventoryChangeKind Kind)
+{
+	if (DeferredNotificationDepth > 0)
+	{
+		DeferredItemChanges.Add({ ItemEntry, LastCount, NewCount, Kind });
+		return;
+	}
+
+	ChangeLog.Record(ItemEntry.ItemHandle, Kind);
+
+	if (Kind == EInventoryChangeKind::Added)
+	{
+		ITEMIZATION_INC_STAT(NumEntries);
+	}
+	else if (Kind == EInventoryChangeKind::Removed)
+	{
+		ITEMIZATION_DEC_STAT(NumEntries);
+	}
+
+	if (Journal.IsValid())
+	{
+		Journal->RecordChange(ItemEntry, Kind);
+	}
+
+	FInventoryItemEvent& ItemEvent =
+		Kind == EInventoryChangeKind::Added ? OnItemAddedDelegate :
+		Kind == EInventoryChangeKind::Removed ? OnItemRemovedDelegate : OnItemChangedDelegate;
+
+	// Only build the payload if somebody is actually listening
+	const bool bHasFilteredSubscribers = EventDispatcher.HasSubscribers();
+	if (ItemEvent.IsBound() || bHasFilteredSubscribers)
+	{
+		FInventoryChangeMessage Payload(&ItemEntry, NewCount, LastCount);
+		Payload.Controller = GetInstigatorController();
+		Payload.Owner = GetOwner();
+		Payload.SourceInventory = Payload.TargetInventory = this;
+
+		ItemEvent.Broadcast(Payload);
+
+		if (bHasFilteredSubscribers)
+		{
+			EventDispatcher.Dispatch(Payload, ItemEntry.ItemDefinition, Kind);
+		}
+	}
+
+	if (OnChangeSetDelegate.IsBound())
+	{
+		PendingChangeSet.RecordChange(ItemEntry.ItemHandle, ItemEntry.ItemDefinition, LastCount, NewCount, Kind);
+		RequestFlush();
+	}
+
+	if (bWantsSnapshots.load(std::memory_order_relaxed))
+	{
+		bSnapshotDirty = true;
+		RequestFlush();
+	}
+}
+
+void AInventoryBase::RequestFlush()
+{
+	// Wake up once to flush at the end of the frame
+	if (!IsActorTickEnabled())
+	{
+		SetActorTickEnabled(true);
+	}
+}
+
+void AInventoryBase::ScheduleOperationFlush()
+{
+	if (IsInGameThread())
+	{
+		RequestFlush();
+		return;
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<ThisClass>(this)]()
+	{
+		if (ThisClass* StrongThis = WeakThis.Get())
+		{
+			StrongThis->RequestFlush();
+		}
+	});
+}
+
+FInventorySnapshotPtr AInventoryBase::GetSnapshot() const
+{
+	if (!bWantsSnapshots.exchange(true))
+	{
+		// First request, build the initial snapshot on the game thread
+		if (IsInGameThread())
+		{
+			const_cast<ThisClass*>(this)->PublishSnapshot();
+		}
+		else
+		{
+			TWeakObjectPtr<ThisClass> WeakThis(const_cast<ThisClass*>(this));
+			AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+			{
+				if (ThisClass* StrongThis = WeakThis.Get())
+				{
+					StrongThis->PublishSnapshot();
+				}
+			});
+		}
+	}
+
+	FReadScopeLock ReadLock(SnapshotLock);
+	return Snapshot;
+}
+
+void AInventoryBase::PublishSnapshot()
+{
+	check(IsInGameThread());
+
+	// Trait bits added later aren't part of the snapshot entries yet, so republish whenever that happens
+	if (!TraitBitAddedHandle.IsValid())
+	{
+		TraitBitAddedHandle = FItemComponentData_Traits::OnTraitBitAdded().AddWeakLambda(this, [this]()
+		{
+			bSnapshotDirty = true;
+			RequestFlush();
+		});
+	}
+
+	TSharedRef<FInventorySnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FInventorySnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->Version = ChangeLog.GetVersion();
+	NewSnapshot->Entries.Reserve(InventoryList.Items.Num());
+
+	for (const FInventoryItemEntry& Entry : InventoryList)
+	{
+		FInventorySnapshotEntry& SnapshotEntry = NewSnapshot->Entries.AddDefaulted_GetRef();
+		SnapshotEntry.ItemHandle = Entry.ItemHandle;
+		SnapshotEntry.StackCount = Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+
+		if (Entry.ItemDefinition)
+		{
+			SnapshotEntry.DefinitionId = Entry.ItemDefinition->GetPrimaryAssetId();
+			SnapshotEntry.TraitBits = FItemComponentData_Traits::GetTraitBits(Entry.ItemDefinition);
+		}
+	}
+
+	bSnapshotDirty = false;
+
+	// Readers holding on to the old snapshot keep it alive until they are done
+	FWriteScopeLock WriteLock(SnapshotLock);
+	Snapshot = MoveTemp(NewSnapshot);
+}
+
+void AInventoryBase::FlushChangeSet()
+{
+	if (PendingChangeSet.IsEmpty())
+	{
+		return;
+	}
+
+	PendingChangeSet.Compact();
+	if (!PendingChangeSet.IsEmpty())
+	{
+		PendingChangeSet.Inventory = this;
+		OnChangeSetDelegate.Broadcast(PendingChangeSet);
+	}
+
+	PendingChangeSet.Reset();
+}
 
-	OnItemAddedDelegate.Broadcast(Payload);
+FDelegateHandle AInventoryBase::SubscribeToItemEvents(
+	const FInventoryEventFilter& Filter,
+	FInventoryFilteredItemEvent Delegate)
+{
+	return EventDispatcher.Subscribe(Filter, MoveTemp(Delegate));
 }
 
+bool AInventoryBase::UnsubscribeFromItemEvents(FDelegateHandle Handle)
+{
+	return EventDispatcher.Unsubscribe(Handle);
+}
+
+void AInventoryBase::SetJournal(TSharedPtr<FInventoryJournal> InJournal)
+{
+	Journal = MoveTemp(InJournal);
+}
+
+int32 AInventoryBase::GetTotalCount(const UItemDefinitionBase* ItemDefinition) const
+{
+	const int32* Total = DefinitionTotals.Find(ItemDefinition);
+	return Total ? *Total : 0;
+}
+
+void AInventoryBase::UpdateTotalCount(const UItemDefinitionBase* ItemDefinition, int32 Delta)
+{
+	if (Delta == 0 || ItemDefinition == nullptr)
+	{
+		return;
+	}
+
+	int32& Total = DefinitionTotals.FindOrAdd(ItemDefinition);
+	const int32 OldTotal = Total;
+	Total = FMath::Max(0, OldTotal + Delta);
+	const int32 NewTotal = Total;
+
+	// Don't keep empty totals around
+	if (NewTotal == 0)
+	{
+		DefinitionTotals.Remove(ItemDefinition);
+	}
+
+	if (DeferredNotificationDepth > 0)
+	{
+		// Only remember the total from before the scope, the broadcast happens once it ends
+		if (!DeferredOldTotals.Contains(ItemDefinition))
+		{
+			DeferredOldTotals.Add(ItemDefinition, OldTotal);
+		}
+	}
+	else if (NewTotal != OldTotal)
+	{
+		OnTotalCountChangedDelegate.Broadcast(ItemDefinition, NewTotal, OldTotal);
+	}
+}
 
 void AInventoryBase::OnRep_InventoryList()
 {
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(OnRepInventoryList);
+
 	for (FInventoryItemEntry& Entry : InventoryList)
 	{
 		if (!IsValid(Entry.GetItemInstance()))
@@ -552,10 +1162,36 @@ void AInventoryBase::RemoveReplicatedItemInstance(UInventoryItemInstance* ItemIn
 	}
 }
 
+void AInventoryBase::AdoptItemInstance(FInventoryItemEntry& ItemEntry)
+{
+	UInventoryItemInstance* Instance = ItemEntry.GetItemInstance();
+	if (!ensure(Instance))
+	{
+		return;
+	}
+
+	if (Instance->GetOuter() != this)
+	{
+		Instance->Rename(nullptr, this, REN_DontCreateRedirectors | REN_DoNotDirty);
+	}
+
+	if (Instance->GetIsReplicated())
+	{
+		AddReplicatedItemInstance(Instance);
+	}
+
+	Instance->OnAddedToInventory(ItemEntry, InventoryHandle);
+}
+
 void AInventoryBase::MarkItemEntryDirty(FInventoryItemEntry& ItemEntry, bool bWasAddOrChange)
 {
+	Metrics.RecordDirtyMark();
+
 	if (Owner->HasAuthority())
 	{
+		// The server never receives the replication callbacks, so track the observed count here
+		ItemEntry.LastObservedStackCount = ItemEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+
 		if (ItemEntry.GetItemInstance() == nullptr || bWasAddOrChange)
 		{
 			InventoryList.MarkItemDirty(ItemEntry);
@@ -0,0 +1,65 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Inventory/InventoryChangeLog.h"
+
+FInventoryChangeLog::FInventoryChangeLog(int32 InCapacity)
+{
+	SetCapacity(InCapacity);
+}
+
+void FInventoryChangeLog::SetCapacity(int32 InCapacity)
+{
+	Entries.Reset();
+	Entries.SetNum(FMath::Max(InCapacity, 0));
+	Head = 0;
+	Num = 0;
+}
+
+void FInventoryChangeLog::Record(const FInventoryItemHandle& ItemHandle, EInventoryChangeKind Kind)
+{
+	++Version;
+
+	const int32 Capacity = Entries.Num();
+	if (Capacity == 0)
+	{
+		return;
+	}
+
+	FInventoryChangeLogEntry& Entry = Entries[Head];
+	Entry.ItemHandle = ItemHandle;
+	Entry.Kind = Kind;
+	Entry.Version = Version;
+
+	Head = (Head + 1) % Capacity;
+	Num = FMath::Min(Num + 1, Capacity);
+}
+
+EInventoryChangeLogReadResult FInventoryChangeLog::ReadChanges(
+	FInventoryChangeCursor& Cursor,
+	TArray<FInventoryChangeLogEntry>& OutChanges) const
+{
+	if (Cursor.Version >= Version)
+	{
+		return EInventoryChangeLogReadResult::UpToDate;
+	}
+
+	// The change right after the cursor has already been overwritten
+	if (Cursor.Version + 1 < GetOldestVersion())
+	{
+		return EInventoryChangeLogReadResult::ResyncRequired;
+	}
+
+	const int32 Capacity = Entries.Num();
+	const int32 NumChanges = static_cast<int32>(Version - Cursor.Version);
+	OutChanges.Reserve(OutChanges.Num() + NumChanges);
+
+	// Walk from the first unseen change up to the head
+	for (int32 Offset = NumChanges; Offset > 0; --Offset)
+	{
+		OutChanges.Add(Entries[(Head - Offset + Capacity) % Capacity]);
+	}
+
+	Cursor.Version = Version;
+	return EInventoryChangeLogReadResult::Changes;
+}
@@ -0,0 +1,55 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Inventory/InventoryChangeSet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryChangeSet)
+
+void FInventoryChangeSet::RecordChange(
+	const FInventoryItemHandle& ItemHandle,
+	UItemDefinitionBase* ItemDefinition,
+	int32 OldStackCount,
+	int32 NewStackCount,
+	EInventoryChangeKind Kind)
+{
+	if (const int32* ExistingIndex = EntryIndices.Find(ItemHandle))
+	{
+		// Keep the stack count of the first change, so we end up with the net delta
+		FInventoryChangeSetEntry& Entry = Entries[*ExistingIndex];
+		Entry.NewStackCount = NewStackCount;
+		Entry.ChangeKinds |= static_cast<uint8>(Kind);
+		return;
+	}
+
+	EntryIndices.Add(ItemHandle, Entries.Num());
+
+	FInventoryChangeSetEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.ItemHandle = ItemHandle;
+	Entry.ItemDefinition = ItemDefinition;
+	Entry.OldStackCount = OldStackCount;
+	Entry.NewStackCount = NewStackCount;
+	Entry.ChangeKinds = static_cast<uint8>(Kind);
+}
+
+void FInventoryChangeSet::Compact()
+{
+	Entries.RemoveAll([](const FInventoryChangeSetEntry& Entry)
+	{
+		// Added and removed within the same frame, nobody has ever seen this entry
+		if (Entry.HasChangeKind(EInventoryChangeKind::Added) && Entry.HasChangeKind(EInventoryChangeKind::Removed))
+		{
+			return true;
+		}
+
+		// Changed back and forth without any net effect
+		return Entry.ChangeKinds == static_cast<uint8>(EInventoryChangeKind::Changed) && Entry.GetDelta() == 0;
+	});
+
+	EntryIndices.Reset();
+}
+
+void FInventoryChangeSet::Reset()
+{
+	Entries.Reset();
+	EntryIndices.Reset();
+}
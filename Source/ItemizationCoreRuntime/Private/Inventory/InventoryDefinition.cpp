@@ -2,3 +2,67 @@
 
 
 #include "Inventory/InventoryDefinition.h"
+
+#include "ItemizationLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryDefinition)
+
+const FInventoryPropertiesBase* UInventoryDefinition::GetInventoryProperties(int32 Index) const
+{
+	if (InventoryList.IsValidIndex(Index))
+	{
+		return &InventoryList[Index];
+	}
+
+	const int32 EquippableIndex = Index - InventoryList.Num();
+	if (EquippableInventoryList.IsValidIndex(EquippableIndex))
+	{
+		return &EquippableInventoryList[EquippableIndex];
+	}
+
+	return nullptr;
+}
+
+uint64 UInventoryDefinition::GetAcceptingInventories(const UItemDefinitionBase* ItemDefinition) const
+{
+	return RoutingTable.GetAcceptingInventories(*this, ItemDefinition);
+}
+
+void UInventoryDefinition::PrewarmRouting(TConstArrayView<const UItemDefinitionBase*> ItemDefinitions) const
+{
+	check(IsInGameThread());
+	RoutingTable.Prewarm(*this, ItemDefinitions);
+}
+
+int32 UInventoryDefinition::FindFirstAcceptingInventory(const UItemDefinitionBase* ItemDefinition) const
+{
+	const uint64 Mask = GetAcceptingInventories(ItemDefinition);
+	return Mask ? static_cast<int32>(FMath::CountTrailingZeros64(Mask)) : INDEX_NONE;
+}
+
+void UInventoryDefinition::PostLoad()
+{
+	Super::PostLoad();
+
+	// The queries might have changed since the table was built
+	RoutingTable.Reset();
+	ValidateNumInventories();
+}
+
+#if WITH_EDITOR
+void UInventoryDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	RoutingTable.Reset();
+	ValidateNumInventories();
+}
+#endif
+
+void UInventoryDefinition::ValidateNumInventories() const
+{
+	if (GetNumInventories() > FInventoryRoutingTable::MaxNumInventories)
+	{
+		ITEMIZATION_WARN("Inventory definition %s has %d inventories, but only the first %d can be routed to. Items will never be routed to the rest.",
+			*GetPathName(), GetNumInventories(), FInventoryRoutingTable::MaxNumInventories);
+	}
+}
@@ -0,0 +1,282 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Inventory/InventoryEventDispatcher.h"
+
+#include "ItemizationLogChannels.h"
+#include "Inventory/InventoryChangeMessage.h"
+#include "Items/ItemDefinitionBase.h"
+#include "Items/Data/ItemComponentData_Traits.h"
+
+FInventoryEventFilter FInventoryEventFilter::ForDefinition(const UItemDefinitionBase* InItemDefinition)
+{
+	FInventoryEventFilter Filter;
+	Filter.ItemDefinition = InItemDefinition;
+	return Filter;
+}
+
+FInventoryEventFilter FInventoryEventFilter::ForTraits(const FGameplayTagContainer& InTraits)
+{
+	FInventoryEventFilter Filter;
+
+	bool bHasValidTraits = false;
+	bool bAllTraitsHaveBits = true;
+	uint64 Bits = 0;
+	for (const FGameplayTag& Trait : InTraits)
+	{
+		if (!Trait.IsValid())
+		{
+			continue;
+		}
+
+		bHasValidTraits = true;
+
+		const uint64 TraitBit = FItemComponentData_Traits::GetTraitBit(Trait);
+		bAllTraitsHaveBits &= TraitBit != 0;
+		Bits |= TraitBit;
+	}
+
+	if (!bHasValidTraits)
+	{
+		Filter.bIsValid = false;
+	}
+	else if (bAllTraitsHaveBits)
+	{
+		Filter.TraitBits = Bits;
+	}
+	else
+	{
+		// Out of trait bits, match the traits one by one instead
+		Filter.TraitQuery = FGameplayTagQuery::MakeQuery_ExactMatchAnyTags(InTraits);
+	}
+
+	return Filter;
+}
+
+FInventoryEventFilter FInventoryEventFilter::ForQuery(const FGameplayTagQuery& InQuery)
+{
+	FInventoryEventFilter Filter;
+	Filter.TraitQuery = InQuery;
+	return Filter;
+}
+
+bool FInventoryEventFilter::Matches(
+	const UItemDefinitionBase* InItemDefinition,
+	uint64 InTraitBits,
+	EInventoryChangeKind Kind) const
+{
+	if (!EnumHasAnyFlags(ChangeKinds, Kind))
+	{
+		return false;
+	}
+
+	if (ItemDefinition && ItemDefinition != InItemDefinition)
+	{
+		return false;
+	}
+
+	if (TraitBits != 0 && (TraitBits & InTraitBits) == 0)
+	{
+		return false;
+	}
+
+	if (!TraitQuery.IsEmpty())
+	{
+		return InItemDefinition && TraitQuery.Matches(FItemComponentData_Traits::GetTraits(InItemDefinition));
+	}
+
+	return true;
+}
+
+FDelegateHandle FInventoryEventDispatcher::Subscribe(const FInventoryEventFilter& Filter, FInventoryFilteredItemEvent&& Delegate)
+{
+	if (!Delegate.IsBound())
+	{
+		return FDelegateHandle();
+	}
+
+	if (!Filter.IsValid())
+	{
+		ITEMIZATION_WARN("Rejected an item event subscription with an invalid filter. Trait filters need at least one valid trait.");
+		return FDelegateHandle();
+	}
+
+	FSubscription Subscription;
+	Subscription.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Subscription.Filter = Filter;
+	Subscription.Delegate = MoveTemp(Delegate);
+
+	const FDelegateHandle Handle = Subscription.Handle;
+	IndexSubscription(Subscriptions.Add(MoveTemp(Subscription)));
+
+	return Handle;
+}
+
+bool FInventoryEventDispatcher::Unsubscribe(FDelegateHandle Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+
+	for (auto It = Subscriptions.CreateIterator(); It; ++It)
+	{
+		if (It->Handle == Handle)
+		{
+			UnindexSubscription(It.GetIndex());
+			It.RemoveCurrent();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FInventoryEventDispatcher::Dispatch(
+	const FInventoryChangeMessage& Message,
+	const UItemDefinitionBase* ItemDefinition,
+	EInventoryChangeKind Kind)
+{
+	if (Subscriptions.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<16>> Matches;
+	GatherMatches(ItemDefinition, FItemComponentData_Traits::GetTraitBits(ItemDefinition), Kind, Matches);
+
+	// Resolve handles up front, subscribers might unsubscribe while being invoked
+	TArray<FDelegateHandle, TInlineAllocator<16>> Handles;
+	Handles.Reserve(Matches.Num());
+	for (const int32 SubscriptionIdx : Matches)
+	{
+		Handles.Add(Subscriptions[SubscriptionIdx].Handle);
+	}
+
+	for (int32 Idx = 0; Idx < Matches.Num(); ++Idx)
+	{
+		const int32 SubscriptionIdx = Matches[Idx];
+		if (Subscriptions.IsValidIndex(SubscriptionIdx) && Subscriptions[SubscriptionIdx].Handle == Handles[Idx])
+		{
+			// Copy, as the subscription array might grow while executing
+			const FInventoryFilteredItemEvent Delegate = Subscriptions[SubscriptionIdx].Delegate;
+			Delegate.ExecuteIfBound(Message);
+		}
+	}
+}
+
+void FInventoryEventDispatcher::GatherMatches(
+	const UItemDefinitionBase* ItemDefinition,
+	uint64 TraitBits,
+	EInventoryChangeKind Kind,
+	TArray<int32, TInlineAllocator<16>>& OutMatches) const
+{
+	auto AddIfMatching = [&](const int32 SubscriptionIdx)
+	{
+		if (Subscriptions[SubscriptionIdx].Filter.Matches(ItemDefinition, TraitBits, Kind))
+		{
+			OutMatches.Add(SubscriptionIdx);
+		}
+	};
+
+	if (const auto* DefinitionSubscriptions = DefinitionIndex.Find(ItemDefinition))
+	{
+		for (const int32 SubscriptionIdx : *DefinitionSubscriptions)
+		{
+			AddIfMatching(SubscriptionIdx);
+		}
+	}
+
+	// A subscription filtering for multiple bits sits in multiple buckets, only visit it through its lowest matching bit
+	for (uint64 Remaining = TraitBits & SubscribedTraitBits; Remaining != 0; Remaining &= Remaining - 1)
+	{
+		const int32 BitIndex = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+		const uint64 LowerBits = (uint64(1) << BitIndex) - 1;
+
+		for (const int32 SubscriptionIdx : TraitBitIndex.FindChecked(BitIndex))
+		{
+			if ((Subscriptions[SubscriptionIdx].Filter.TraitBits & TraitBits & LowerBits) == 0)
+			{
+				AddIfMatching(SubscriptionIdx);
+			}
+		}
+	}
+
+	for (const int32 SubscriptionIdx : QuerySubscriptions)
+	{
+		AddIfMatching(SubscriptionIdx);
+	}
+
+	for (const int32 SubscriptionIdx : UnfilteredSubscriptions)
+	{
+		AddIfMatching(SubscriptionIdx);
+	}
+}
+
+void FInventoryEventDispatcher::IndexSubscription(int32 SubscriptionIdx)
+{
+	const FInventoryEventFilter& Filter = Subscriptions[SubscriptionIdx].Filter;
+
+	// Sort the subscription into the most selective index, the remaining criteria are checked when dispatching
+	if (Filter.ItemDefinition)
+	{
+		DefinitionIndex.FindOrAdd(Filter.ItemDefinition).Add(SubscriptionIdx);
+	}
+	else if (Filter.TraitBits != 0)
+	{
+		for (uint64 Remaining = Filter.TraitBits; Remaining != 0; Remaining &= Remaining - 1)
+		{
+			TraitBitIndex.FindOrAdd(static_cast<int32>(FMath::CountTrailingZeros64(Remaining))).Add(SubscriptionIdx);
+		}
+		SubscribedTraitBits |= Filter.TraitBits;
+	}
+	else if (!Filter.TraitQuery.IsEmpty())
+	{
+		QuerySubscriptions.Add(SubscriptionIdx);
+	}
+	else
+	{
+		UnfilteredSubscriptions.Add(SubscriptionIdx);
+	}
+}
+
+void FInventoryEventDispatcher::UnindexSubscription(int32 SubscriptionIdx)
+{
+	const FInventoryEventFilter& Filter = Subscriptions[SubscriptionIdx].Filter;
+
+	if (Filter.ItemDefinition)
+	{
+		if (auto* DefinitionSubscriptions = DefinitionIndex.Find(Filter.ItemDefinition))
+		{
+			DefinitionSubscriptions->RemoveSingleSwap(SubscriptionIdx);
+			if (DefinitionSubscriptions->IsEmpty())
+			{
+				DefinitionIndex.Remove(Filter.ItemDefinition);
+			}
+		}
+	}
+	else if (Filter.TraitBits != 0)
+	{
+		for (uint64 Remaining = Filter.TraitBits; Remaining != 0; Remaining &= Remaining - 1)
+		{
+			const int32 BitIndex = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+			if (auto* BitSubscriptions = TraitBitIndex.Find(BitIndex))
+			{
+				BitSubscriptions->RemoveSingleSwap(SubscriptionIdx);
+				if (BitSubscriptions->IsEmpty())
+				{
+					TraitBitIndex.Remove(BitIndex);
+					SubscribedTraitBits &= ~(uint64(1) << BitIndex);
+				}
+			}
+		}
+	}
+	else if (!Filter.TraitQuery.IsEmpty())
+	{
+		QuerySubscriptions.RemoveSingleSwap(SubscriptionIdx);
+	}
+	else
+	{
+		UnfilteredSubscriptions.RemoveSingleSwap(SubscriptionIdx);
+	}
+}
@@ -0,0 +1,276 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Inventory/InventoryMetrics.h"
+
+#include "Algo/Find.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/OutputDevice.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+#include "Inventory/InventoryBase.h"
+#include "Transactions/InventoryItemGiveOp.h"
+#include "Transactions/InventoryItemRemoveOp.h"
+
+CSV_DEFINE_CATEGORY(Itemization, true);
+
+namespace UE::ItemizationCore::Metrics
+{
+	static bool bMetricsEnabled = true;
+
+	/** Sort keys accepted by Itemization.Metrics.Top. */
+	static const TCHAR* SortKeys[] = { TEXT("time"), TEXT("bytes"), TEXT("ops"), TEXT("entries") };
+	static FAutoConsoleVariableRef CVarMetricsEnabled(
+		TEXT("Itemization.Metrics.Enabled"),
+		bMetricsEnabled,
+		TEXT("Whether runtime cost metrics are collected for every inventory."));
+
+	/** Returns the cost of an inventory by the given sort key. */
+	static double GetInventoryCost(const AInventoryBase& Inventory, const FString& SortBy)
+	{
+		const FInventoryMetricsWindow& Window = Inventory.GetMetrics().GetLastWindow();
+		if (SortBy == TEXT("bytes"))
+		{
+			return static_cast<double>(Window.NumReplicatedBits);
+		}
+		if (SortBy == TEXT("ops"))
+		{
+			return Window.NumOps;
+		}
+		if (SortBy == TEXT("entries"))
+		{
+			return Inventory.GetNumItemEntries();
+		}
+
+		return Window.GetTotalSeconds();
+	}
+
+	/**
+	 * Lists the most expensive inventories of the world over the last metrics window.
+	 *
+	 * Usage: Itemization.Metrics.Top [Count=10] [SortBy=time|bytes|ops|entries]
+	 */
+	static void DumpTopInventories(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (World == nullptr)
+		{
+			return;
+		}
+
+		const int32 Count = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+		const FString SortBy = Args.IsValidIndex(1) ? Args[1].ToLower() : TEXT("time");
+
+		if (!Algo::FindByPredicate(SortKeys, [&SortBy](const TCHAR* SortKey) { return SortBy == SortKey; }))
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("Unknown sort key '%s', expected one of time, bytes, ops or entries."), *SortBy);
+			return;
+		}
+
+		if (!FInventoryMetrics::IsEnabled())
+		{
+			Ar.Log(TEXT("Inventory metrics are disabled, enable them with Itemization.Metrics.Enabled 1"));
+			return;
+		}
+
+		TArray<TPair<double, const AInventoryBase*>> Inventories;
+		for (TActorIterator<AInventoryBase> It(World); It; ++It)
+		{
+			Inventories.Emplace(GetInventoryCost(**It, SortBy), *It);
+		}
+
+		Inventories.Sort([](const TPair<double, const AInventoryBase*>& A, const TPair<double, const AInventoryBase*>& B)
+		{
+			return A.Key > B.Key;
+		});
+
+		Ar.Logf(TEXT("Top %d of %d inventories by %s over the last %.0f s:"),
+			FMath::Min(Count, Inventories.Num()), Inventories.Num(), *SortBy, FInventoryMetrics::WindowSeconds);
+
+		for (int32 Idx = 0; Idx < FMath::Min(Count, Inventories.Num()); ++Idx)
+		{
+			const AInventoryBase* Inventory = Inventories[Idx].Value;
+			const FInventoryMetricsWindow& Window = Inventory->GetMetrics().GetLastWindow();
+
+			FString OpsByType;
+			for (const TPair<const TCHAR*, uint32>& Op : Window.OpsByType)
+			{
+				OpsByType += FString::Printf(TEXT(" %s=%u"), Op.Key, Op.Value);
+			}
+
+			Ar.Logf(TEXT("\t%s (%s): %d entries, %d instances, %u ops/s [%s ], %u dirty marks/s, %llu bytes/s, give %.3f ms/s, remove %.3f ms/s"),
+				*GetNameSafe(Inventory),
+				*GetNameSafe(Inventory->GetOwner()),
+				Inventory->GetNumItemEntries(),
+				Inventory->GetAllItemInstances().Num(),
+				Window.NumOps,
+				*OpsByType,
+				Window.NumDirtyMarks,
+				(Window.NumReplicatedBits + 7) / 8,
+				Window.GiveSeconds * 1000.0,
+				Window.RemoveSeconds * 1000.0);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpTopInventoriesCommand(
+		TEXT("Itemization.Metrics.Top"),
+		TEXT("Lists the most expensive inventories of the world over the last second. Args: [Count=10] [SortBy=time|bytes|ops|entries]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpTopInventories));
+}
+
+void FInventoryMetricsWindow::Reset()
+{
+	OpsByType.Reset();
+	NumOps = 0;
+	NumDirtyMarks = 0;
+	NumReplicatedBits = 0;
+	GiveSeconds = 0.0;
+	RemoveSeconds = 0.0;
+}
+
+FInventoryMetrics::FScopedTimer::FScopedTimer(FInventoryMetrics& InMetrics, ETimer InTimer)
+	: Metrics(InMetrics)
+	, Timer(InTimer)
+{
+	if (Metrics.TimerDepth++ == 0 && IsEnabled())
+	{
+		// Direct gives and removes, e.g. from the library, never pass the op cache
+		if (Metrics.QueuedOpDepth == 0)
+		{
+			Metrics.RecordOp(Timer == ETimer::Give ? FInventoryItemGiveOp::Name : FInventoryItemRemoveOp::Name);
+		}
+
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+FInventoryMetrics::FScopedTimer::~FScopedTimer()
+{
+	if (--Metrics.TimerDepth == 0 && StartCycles != 0)
+	{
+		Metrics.RecordTime(Timer, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+	}
+}
+
+FInventoryMetrics::FScopedQueuedOps::FScopedQueuedOps(FInventoryMetrics& InMetrics)
+	: Metrics(InMetrics)
+{
+	++Metrics.QueuedOpDepth;
+}
+
+FInventoryMetrics::FScopedQueuedOps::~FScopedQueuedOps()
+{
+	--Metrics.QueuedOpDepth;
+}
+
+bool FInventoryMetrics::IsEnabled()
+{
+	return UE::ItemizationCore::Metrics::bMetricsEnabled;
+}
+
+void FInventoryMetrics::RecordOp(const TCHAR* OpTypeName)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	Advance();
+	++CurrentWindow.OpsByType.FindOrAdd(OpTypeName);
+	++CurrentWindow.NumOps;
+	++TotalNumOps;
+
+	CSV_CUSTOM_STAT(Itemization, NumOps, 1, ECsvCustomStatOp::Accumulate);
+}
+
+void FInventoryMetrics::RecordDirtyMark()
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	Advance();
+	++CurrentWindow.NumDirtyMarks;
+
+	CSV_CUSTOM_STAT(Itemization, NumDirtyMarks, 1, ECsvCustomStatOp::Accumulate);
+}
+
+void FInventoryMetrics::RecordReplicatedBits(int64 NumBits)
+{
+	if (!IsEnabled() || NumBits <= 0)
+	{
+		return;
+	}
+
+	Advance();
+	CurrentWindow.NumReplicatedBits += NumBits;
+
+	CSV_CUSTOM_STAT(Itemization, ReplicatedBytes, static_cast<int32>((NumBits + 7) / 8), ECsvCustomStatOp::Accumulate);
+}
+
+void FInventoryMetrics::RecordTime(ETimer Timer, double Seconds)
+{
+	Advance();
+	CurrentFrameSeconds += Seconds;
+
+	if (Timer == ETimer::Give)
+	{
+		CurrentWindow.GiveSeconds += Seconds;
+		CSV_CUSTOM_STAT(Itemization, GiveMs, Seconds * 1000.0, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		CurrentWindow.RemoveSeconds += Seconds;
+		CSV_CUSTOM_STAT(Itemization, RemoveMs, Seconds * 1000.0, ECsvCustomStatOp::Accumulate);
+	}
+}
+
+const FInventoryMetricsWindow& FInventoryMetrics::GetLastWindow() const
+{
+	static const FInventoryMetricsWindow EmptyWindow;
+
+	// Nothing has been recorded for a whole window, so the last window is outdated
+	return FApp::GetCurrentTime() - CurrentWindowStart >= WindowSeconds * 2.0 ? EmptyWindow : LastWindow;
+}
+
+double FInventoryMetrics::GetLastFrameSeconds() const
+{
+	if (CurrentFrame == GFrameCounter)
+	{
+		return LastFrameSeconds;
+	}
+
+	return CurrentFrame + 1 == GFrameCounter ? CurrentFrameSeconds : 0.0;
+}
+
+void FInventoryMetrics::Advance()
+{
+	if (CurrentFrame != GFrameCounter)
+	{
+		LastFrameSeconds = CurrentFrame + 1 == GFrameCounter ? CurrentFrameSeconds : 0.0;
+		CurrentFrameSeconds = 0.0;
+		CurrentFrame = GFrameCounter;
+	}
+
+	const double Now = FApp::GetCurrentTime();
+	if (Now - CurrentWindowStart < WindowSeconds)
+	{
+		return;
+	}
+
+	// Windows without any activity in between leave an empty last window
+	if (Now - CurrentWindowStart < WindowSeconds * 2.0)
+	{
+		Swap(LastWindow, CurrentWindow);
+	}
+	else
+	{
+		LastWindow.Reset();
+	}
+
+	CurrentWindow.Reset();
+	CurrentWindowStart = Now;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Inventory/InventoryRoutingTable.h"
+
+#include "Inventory/InventoryDefinition.h"
+#include "Items/ItemDefinitionBase.h"
+#include "Items/Data/ItemComponentData_Traits.h"
+
+namespace UE::ItemizationCore::Routing
+{
+	/** Bumped whenever any routing table has to be rebuilt. Starts at 1, so default constructed tables are stale. */
+	static uint32 GRoutingGeneration = 1;
+}
+
+uint64 FInventoryRoutingTable::GetAcceptingInventories(
+	const UInventoryDefinition& InventoryDefinition,
+	const UItemDefinitionBase* ItemDefinition)
+{
+	check(IsInGameThread());
+	
+	if (ItemDefinition == nullptr)
+	{
+		return 0;
+	}
+
+	ValidateGeneration();
+
+	if (const uint64* CachedMask = AcceptingInventories.Find(ItemDefinition))
+	{
+		return *CachedMask;
+	}
+
+	const uint64 Mask = EvaluateItem(InventoryDefinition, ItemDefinition);
+	AcceptingInventories.Add(ItemDefinition, Mask);
+	return Mask;
+}
+
+void FInventoryRoutingTable::Prewarm(
+	const UInventoryDefinition& InventoryDefinition,
+	TConstArrayView<const UItemDefinitionBase*> ItemDefinitions)
+{
+	check(IsInGameThread());
+
+	ValidateGeneration();
+	AcceptingInventories.Reserve(AcceptingInventories.Num() + ItemDefinitions.Num());
+
+	for (const UItemDefinitionBase* ItemDefinition : ItemDefinitions)
+	{
+		if (ItemDefinition && !AcceptingInventories.Contains(ItemDefinition))
+		{
+			AcceptingInventories.Add(ItemDefinition, EvaluateItem(InventoryDefinition, ItemDefinition));
+		}
+	}
+}
+
+void FInventoryRoutingTable::Reset()
+{
+	AcceptingInventories.Reset();
+	Generation = 0;
+}
+
+void FInventoryRoutingTable::InvalidateAll()
+{
+	++UE::ItemizationCore::Routing::GRoutingGeneration;
+}
+
+uint64 FInventoryRoutingTable::EvaluateItem(
+	const UInventoryDefinition& InventoryDefinition,
+	const UItemDefinitionBase* ItemDefinition)
+{
+	const FGameplayTagContainer& ItemTags = FItemComponentData_Traits::GetTraits(ItemDefinition);
+
+	// Definitions created at runtime skip the validation on load, so catch them here at least once
+	ensureMsgf(InventoryDefinition.GetNumInventories() <= MaxNumInventories,
+		TEXT("Inventory definition %s has more than %d inventories, the rest can't be routed to."), *InventoryDefinition.GetPathName(), MaxNumInventories);
+
+	uint64 Mask = 0;
+	const int32 NumInventories = FMath::Min(InventoryDefinition.GetNumInventories(), MaxNumInventories);
+	for (int32 Index = 0; Index < NumInventories; ++Index)
+	{
+		const FInventoryPropertiesBase* Properties = InventoryDefinition.GetInventoryProperties(Index);
+		if (Properties && Properties->AcceptsItem(ItemTags))
+		{
+			Mask |= uint64(1) << Index;
+		}
+	}
+
+	return Mask;
+}
+
+void FInventoryRoutingTable::ValidateGeneration()
+{
+	if (Generation != UE::ItemizationCore::Routing::GRoutingGeneration)
+	{
+		AcceptingInventories.Reset();
+		Generation = UE::ItemizationCore::Routing::GRoutingGeneration;
+	}
+}
@@ -0,0 +1,40 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Inventory/InventorySnapshot.h"
+
+const FInventorySnapshotEntry* FInventorySnapshot::FindEntry(const FInventoryItemHandle& ItemHandle) const
+{
+	return Entries.FindByPredicate([&ItemHandle](const FInventorySnapshotEntry& Entry)
+	{
+		return Entry.ItemHandle == ItemHandle;
+	});
+}
+
+int32 FInventorySnapshot::GetTotalCount(const FPrimaryAssetId& DefinitionId) const
+{
+	int32 Total = 0;
+	for (const FInventorySnapshotEntry& Entry : Entries)
+	{
+		if (Entry.DefinitionId == DefinitionId)
+		{
+			Total += Entry.StackCount;
+		}
+	}
+
+	return Total;
+}
+
+int32 FInventorySnapshot::GetTotalCountWithTraits(uint64 TraitBits) const
+{
+	int32 Total = 0;
+	for (const FInventorySnapshotEntry& Entry : Entries)
+	{
+		if ((Entry.TraitBits & TraitBits) != 0)
+		{
+			Total += Entry.StackCount;
+		}
+	}
+
+	return Total;
+}
@@ -3,6 +3,7 @@
 #include "InventoryConfig.h"
 
 #if WITH_EDITOR
+#include "Items/InventoryItemSlot.h"
 #include "Misc/DataValidation.h"
 
 #define LOCTEXT_NAMESPACE "InventoryConfig"
@@ -39,6 +40,17 @@ EDataValidationResult UInventoryConfig::IsDataValid(class FDataValidationContext
 				FText::AsNumber(Config.NumItemRows),
 				FText::AsNumber(Config.NumItemColumns)));
 		}
+
+		if (Config.NumItemColumns > static_cast<uint32>(FInventoryItemSlotGroup::MaxNumColumns))
+		{
+			// Every row of a slot group is stored as a single occupancy word
+			Result = EDataValidationResult::Invalid;
+
+			Context.AddError(FText::Format(LOCTEXT("TooManyGroupColumnsError",
+				"has too many columns {0}. A group supports at most {1} columns."),
+				FText::AsNumber(Config.NumItemColumns),
+				FText::AsNumber(FInventoryItemSlotGroup::MaxNumColumns)));
+		}
 	}
 
 	return Result;
@@ -3,9 +3,19 @@
 
 #include "InventoryItemHandle.h"
 
-void FInventoryItemHandle::GenerateNewUID()
+namespace UE::ItemizationCore::Private
 {
 	// Must be in C++ to avoid duplicate statics across execution units
 	static uint32 GHandle = 1;
-	UID = GHandle++;
+}
+
+void FInventoryItemHandle::GenerateNewUID()
+{
+	UID = UE::ItemizationCore::Private::GHandle++;
+}
+
+void FInventoryItemHandle::ReserveUIDs(uint32 MaxUsedUID)
+{
+	uint32& GHandle = UE::ItemizationCore::Private::GHandle;
+	GHandle = FMath::Max(GHandle, MaxUsedUID + 1);
 }
@@ -3,6 +3,11 @@
 #include "ISettingsModule.h"
 #include "ItemizationCoreSettings.h"
 
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "Debug/GameplayDebuggerCategory_Inventory.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "FItemizationCoreRuntimeModule"
 
 /** The implementation of the ItemizationCore module. */
@@ -32,10 +37,28 @@ void FItemizationCoreModule::StartupModule()
 			LOCTEXT("ItemizationCoreSettingsDescription", "Configure the itemization core settings."),
 			UItemizationCoreSettings::GetMutable());
 	}
+
+#if WITH_GAMEPLAY_DEBUGGER
+	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+	GameplayDebuggerModule.RegisterCategory(
+		"Inventory",
+		IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_Inventory::MakeInstance),
+		EGameplayDebuggerCategoryState::EnabledInGameAndSimulate);
+	GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
 }
 
 void FItemizationCoreModule::ShutdownModule()
 {
+#if WITH_GAMEPLAY_DEBUGGER
+	if (IGameplayDebugger::IsAvailable())
+	{
+		IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+		GameplayDebuggerModule.UnregisterCategory("Inventory");
+		GameplayDebuggerModule.NotifyCategoriesChanged();
+	}
+#endif
+
 	if (SettingsModule == nullptr)
 	{
 		SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
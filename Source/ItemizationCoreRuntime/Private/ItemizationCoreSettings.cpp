@@ -14,6 +14,17 @@ UItemizationCoreSettings::UItemizationCoreSettings(const FObjectInitializer& Obj
 	CountTowardsLimitTag = Itemization::Tags::TAG_ItemTrait_InventorySizeLimited;
 	SingleStackTag = Itemization::Tags::TAG_ItemTrait_SingleStack;
 	TransientTag = Itemization::Tags::TAG_ItemTrait_Transient;
+
+	ChangeLogCapacity = 256;
+	JournalCompactionThreshold = 512;
+	SaveCoalescingWindow = 5.f;
+	MaxInventoriesPerWrite = 64;
+
+	ConnectionRequestBudget = FInventoryRequestBudget(128.f, 64.f);
+	InventoryRequestBudget = FInventoryRequestBudget(64.f, 32.f);
+	RemoveRequestCost = 1.f;
+	MoveRequestCost = 2.f;
+	PlaceRequestCost = 1.f;
 }
 
 const UItemizationCoreSettings* UItemizationCoreSettings::Get()
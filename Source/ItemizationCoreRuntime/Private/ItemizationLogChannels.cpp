@@ -8,6 +8,7 @@ extern ENGINE_API FString GPlayInEditorContextString;
 #endif
 
 DEFINE_LOG_CATEGORY(LogItemization)
+DEFINE_LOG_CATEGORY(LogItemizationItems)
 
 FString UE::ItemizationCore::GetNetContextString(const UObject* Obj)
 {
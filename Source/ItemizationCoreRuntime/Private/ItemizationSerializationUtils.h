@@ -0,0 +1,16 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::ItemizationCore
+{
+	/** Writes a signed value as zigzag encoded varint, so small negative values stay small. Shared by the net requests and the save data. */
+	inline void SerializeZigZag(FArchive& Ar, int32& Value)
+	{
+		uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+		Ar.SerializeIntPacked(Encoded);
+		Value = static_cast<int32>((Encoded >> 1) ^ (~(Encoded & 1) + 1));
+	}
+}
\ No newline at end of file
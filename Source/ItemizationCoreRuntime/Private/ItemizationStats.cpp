@@ -0,0 +1,23 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "ItemizationStats.h"
+
+#if ITEMIZATION_WITH_STATS
+
+UE_TRACE_CHANNEL_DEFINE(ItemizationChannel);
+
+DEFINE_STAT(STAT_Itemization_GiveItem);
+DEFINE_STAT(STAT_Itemization_NativeGiveItem);
+DEFINE_STAT(STAT_Itemization_NativeRemoveItem);
+DEFINE_STAT(STAT_Itemization_EvaluateItemEntry);
+DEFINE_STAT(STAT_Itemization_CreateNewInstanceOfItem);
+DEFINE_STAT(STAT_Itemization_ReplicateSubobjects);
+DEFINE_STAT(STAT_Itemization_OnRepInventoryList);
+DEFINE_STAT(STAT_Itemization_ExecutePendingOperations);
+
+DEFINE_STAT(STAT_Itemization_NumEntries);
+DEFINE_STAT(STAT_Itemization_NumInstances);
+DEFINE_STAT(STAT_Itemization_NumOperations);
+
+#endif
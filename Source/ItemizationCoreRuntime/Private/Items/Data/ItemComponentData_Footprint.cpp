@@ -0,0 +1,46 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Items/Data/ItemComponentData_Footprint.h"
+
+#include "Items/ItemDefinitionBase.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "ItemComponentData_Footprint"
+
+FItemComponentData_Footprint::FItemComponentData_Footprint()
+{
+}
+
+FInventorySlotFootprint FItemComponentData_Footprint::GetFootprint(const UItemDefinitionBase* InItemDefinition)
+{
+	if (const FItemComponentData_Footprint* FootprintData = InItemDefinition->GetItemData<FItemComponentData_Footprint>())
+	{
+		return FootprintData->Footprint;
+	}
+
+	return FInventorySlotFootprint();
+}
+
+#if WITH_EDITOR
+EDataValidationResult FItemComponentData_Footprint::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = FItemComponentData::IsDataValid(Context);
+
+	if (Footprint.Width < 1 || Footprint.Height < 1 || Footprint.Width > FInventoryItemSlotGroup::MaxNumColumns)
+	{
+		Result = EDataValidationResult::Invalid;
+		Context.AddError(FText::Format(LOCTEXT("InvalidFootprintError",
+			"has an invalid footprint {0}x{1}."),
+			FText::AsNumber(Footprint.Width),
+			FText::AsNumber(Footprint.Height)));
+	}
+
+	return Result;
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
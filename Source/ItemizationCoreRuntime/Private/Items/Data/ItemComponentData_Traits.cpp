@@ -3,7 +3,35 @@
 
 #include "Items/Data/ItemComponentData_Traits.h"
 
+#include "Async/Async.h"
 #include "Items/ItemDefinitionBase.h"
+#include "ItemizationLogChannels.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace UE::ItemizationCore::Traits
+{
+	/** Bit index assigned to each trait that has been requested as a trait bit so far. Guarded by GTraitBitLock. */
+	static TMap<FGameplayTag, int32> GTraitBitIndices;
+	static FRWLock GTraitBitLock;
+
+	/** Number of assigned bits, readable without taking the lock. */
+	static std::atomic<int32> GNumTraitBits = 0;
+
+	static void BroadcastTraitBitAdded()
+	{
+		if (IsInGameThread())
+		{
+			FItemComponentData_Traits::OnTraitBitAdded().Broadcast();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, []()
+			{
+				FItemComponentData_Traits::OnTraitBitAdded().Broadcast();
+			});
+		}
+	}
+}
 
 FItemComponentData_Traits::FItemComponentData_Traits()
 {
@@ -19,6 +47,108 @@ bool FItemComponentData_Traits::HasTrait(const UItemDefinitionBase* InItemDefini
 	return false;
 }
 
+const FGameplayTagContainer& FItemComponentData_Traits::GetTraits(const UItemDefinitionBase* InItemDefinition)
+{
+	if (const FItemComponentData_Traits* TraitsData = InItemDefinition->GetItemData<FItemComponentData_Traits>())
+	{
+		return TraitsData->Traits;
+	}
+
+	return FGameplayTagContainer::EmptyContainer;
+}
+
+uint64 FItemComponentData_Traits::GetTraitBit(const FGameplayTag& Trait)
+{
+	using namespace UE::ItemizationCore::Traits;
+
+	if (!Trait.IsValid())
+	{
+		return 0;
+	}
+
+	{
+		FReadScopeLock ReadLock(GTraitBitLock);
+		if (const int32* BitIndex = GTraitBitIndices.Find(Trait))
+		{
+			return uint64(1) << *BitIndex;
+		}
+	}
+
+	int32 NewBitIndex;
+	{
+		FWriteScopeLock WriteLock(GTraitBitLock);
+
+		// Someone else might have assigned it in between
+		if (const int32* BitIndex = GTraitBitIndices.Find(Trait))
+		{
+			return uint64(1) << *BitIndex;
+		}
+
+		if (GTraitBitIndices.Num() >= MaxNumTraitBits)
+		{
+			ITEMIZATION_WARN("Out of trait bits, trait '%s' can't be represented as a trait bit.", *Trait.ToString());
+			return 0;
+		}
+
+		NewBitIndex = GTraitBitIndices.Num();
+		GTraitBitIndices.Add(Trait, NewBitIndex);
+		GNumTraitBits.store(GTraitBitIndices.Num());
+	}
+
+	BroadcastTraitBitAdded();
+	return uint64(1) << NewBitIndex;
+}
+
+uint64 FItemComponentData_Traits::MakeTraitBits(const FGameplayTagContainer& InTraits)
+{
+	uint64 Bits = 0;
+	for (const FGameplayTag& Trait : InTraits)
+	{
+		Bits |= GetTraitBit(Trait);
+	}
+
+	return Bits;
+}
+
+uint64 FItemComponentData_Traits::FindTraitBits(const FGameplayTagContainer& InTraits)
+{
+	using namespace UE::ItemizationCore::Traits;
+
+	uint64 Bits = 0;
+	if (GNumTraitBits.load() > 0 && !InTraits.IsEmpty())
+	{
+		FReadScopeLock ReadLock(GTraitBitLock);
+		for (const FGameplayTag& Trait : InTraits)
+		{
+			if (const int32* BitIndex = GTraitBitIndices.Find(Trait))
+			{
+				Bits |= uint64(1) << *BitIndex;
+			}
+		}
+	}
+
+	return Bits;
+}
+
+uint64 FItemComponentData_Traits::GetTraitBits(const UItemDefinitionBase* InItemDefinition)
+{
+	return InItemDefinition ? FindTraitBits(GetTraits(InItemDefinition)) : 0;
+}
+
+void FItemComponentData_Traits::RegisterTraitBits(const UItemDefinitionBase* InItemDefinition)
+{
+	if (InItemDefinition)
+	{
+		MakeTraitBits(GetTraits(InItemDefinition));
+	}
+}
+
+FSimpleMulticastDelegate& FItemComponentData_Traits::OnTraitBitAdded()
+{
+	static FSimpleMulticastDelegate TraitBitAdded;
+	return TraitBitAdded;
+}
+
 #if WITH_EDITOR
 EDataValidationResult FItemComponentData_Traits::IsDataValid(FDataValidationContext& Context) const
 {
@@ -38,9 +38,9 @@ void FInventoryItemEntry::DebugPrintStats() const
 #if ENABLE_DRAW_DEBUG
 	for (const auto& Pair : GetAllStats())
 	{
-		ITEMIZATION_LOG("\t%s: %s",
-			*Pair.Key.ToString(),
-			*FString::Printf(TEXT("%d"), Pair.Value));
+		ITEMIZATION_ITEM_LOGFMT(VeryVerbose, "\t{Stat}: {Value}",
+			("Stat", Pair.Key.ToString()),
+			("Value", Pair.Value));
 	}
 #endif
 }
@@ -92,6 +92,12 @@ void FInventoryItemEntry::SetNonReplicatedItemInstance(UInventoryItemInstance* I
 	NonReplicatedInstance = InInstance;
 }
 
+void FInventoryItemEntry::ClearItemInstance()
+{
+	ReplicatedInstance = nullptr;
+	NonReplicatedInstance = nullptr;
+}
+
 int32 FInventoryItemEntry::GetStatValue(const FGameplayTag& Tag) const
 {
 	if (TagCountMap.Contains(Tag))
@@ -111,6 +117,9 @@ void FInventoryItemEntry::PreReplicatedRemove(const FInventoryItemContainer& InA
 {
 	if (InArraySerializer.OwningInventory)
 	{
+		// The last observed count is what we have added to the totals so far
+		InArraySerializer.OwningInventory->UpdateTotalCount(ItemDefinition, -FMath::Max(LastObservedStackCount, 0));
+		InArraySerializer.OwningInventory->UpdateNumLimitedSlots(ItemDefinition, -1);
 		InArraySerializer.OwningInventory->OnRemoveItem(*this);
 	}
 }
@@ -119,12 +128,23 @@ void FInventoryItemEntry::PostReplicatedAdd(const FInventoryItemContainer& InArr
 {
 	if (InArraySerializer.OwningInventory)
 	{
+		InArraySerializer.OwningInventory->UpdateTotalCount(ItemDefinition,
+			FMath::Max(GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize), 0));
+		InArraySerializer.OwningInventory->UpdateNumLimitedSlots(ItemDefinition, 1);
 		InArraySerializer.OwningInventory->OnGiveItem(*this);
 	}
 }
 
 void FInventoryItemEntry::PostReplicatedChange(const FInventoryItemContainer& InArraySerializer)
 {
+	if (InArraySerializer.OwningInventory)
+	{
+		// LastObservedStackCount still holds the previous count, the container updates it afterward
+		const int32 NewStackCount = FMath::Max(GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize), 0);
+		InArraySerializer.OwningInventory->UpdateTotalCount(ItemDefinition,
+			NewStackCount - FMath::Max(LastObservedStackCount, 0));
+		InArraySerializer.OwningInventory->NotifyItemChanged(*this, LastObservedStackCount, NewStackCount);
+	}
 }
 
 FInventoryItemContainer::FInventoryItemContainer()
@@ -137,6 +157,19 @@ FInventoryItemContainer::FInventoryItemContainer(AInventoryBase* InOwningInvento
 {
 }
 
+bool FInventoryItemContainer::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	const int64 StartNumBits = DeltaParms.Writer ? DeltaParms.Writer->GetNumBits() : 0;
+	const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FInventoryItemEntry, FInventoryItemContainer>(Items, DeltaParms, *this);
+
+	if (DeltaParms.Writer && OwningInventory)
+	{
+		OwningInventory->GetMetrics().RecordReplicatedBits(DeltaParms.Writer->GetNumBits() - StartNumBits);
+	}
+
+	return bResult;
+}
+
 void FInventoryItemContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
 	for (const int32 Index : RemovedIndices)
@@ -4,6 +4,7 @@
 #include "Items/InventoryItemInstance.h"
 
 #include "ItemizationLogChannels.h"
+#include "ItemizationStats.h"
 #include "Inventory/InventoryBase.h"
 #include "Items/InventoryItemEntry.h"
 #include "Net/UnrealNetwork.h"
@@ -112,6 +113,21 @@ void UInventoryItemInstance::GetLifetimeReplicatedProps(TArray<class FLifetimePr
 void UInventoryItemInstance::PostInitProperties()
 {
 	UObject::PostInitProperties();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		ITEMIZATION_INC_STAT(NumInstances);
+	}
+}
+
+void UInventoryItemInstance::BeginDestroy()
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		ITEMIZATION_DEC_STAT(NumInstances);
+	}
+
+	UObject::BeginDestroy();
 }
 
 #if UE_WITH_IRIS
@@ -3,3 +3,443 @@
 
 #include "Items/InventoryItemSlot.h"
 
+#include "InventoryGroupConfig.h"
+#include "Algo/StableSort.h"
+
+namespace UE::ItemizationCore::SlotBits
+{
+	/** Returns a mask where bit N is set if the bits N to N + Length - 1 are all set in FreeBits. */
+	static uint64 MakeRunStartMask(uint64 FreeBits, int32 Length)
+	{
+		// Double the covered run length with every step, so a run of length L costs log2(L) shifts
+		uint64 RunStarts = FreeBits;
+		int32 Covered = 1;
+		while (Covered < Length && RunStarts != 0)
+		{
+			const int32 Shift = FMath::Min(Covered, Length - Covered);
+			RunStarts &= RunStarts >> Shift;
+			Covered += Shift;
+		}
+
+		return RunStarts;
+	}
+
+	/** Returns a mask with Width bits set, starting at the given column. */
+	static uint64 MakeColumnMask(int32 ColumnIndex, int32 Width)
+	{
+		const uint64 Bits = Width >= 64 ? MAX_uint64 : ((uint64(1) << Width) - 1);
+		return Bits << ColumnIndex;
+	}
+}
+
+void FInventoryItemSlotGroup::Initialize(const FInventoryGroupConfig& Config)
+{
+	ensureMsgf(Config.NumItemColumns <= static_cast<uint32>(MaxNumColumns),
+		TEXT("Inventory group [%s] has %u columns, only %d are supported."),
+		*Config.GroupType.ToString(), Config.NumItemColumns, MaxNumColumns);
+
+	GroupTag = Config.GroupType;
+	NumRows = static_cast<int32>(Config.NumItemRows);
+	NumColumns = FMath::Min(static_cast<int32>(Config.NumItemColumns), MaxNumColumns);
+	ColumnMask = NumColumns >= 64 ? MAX_uint64 : ((uint64(1) << NumColumns) - 1);
+	NumFreeSlots = NumRows * NumColumns;
+	Placements.Reset();
+
+	// Every row starts out empty
+	RowOccupancy.SetNumZeroed(NumRows);
+	RowsWithRoom.SetNumZeroed(FMath::DivideAndRoundUp(NumRows, 64));
+	if (NumColumns > 0)
+	{
+		for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+		{
+			RowsWithRoom[RowIndex >> 6] |= uint64(1) << (RowIndex & 63);
+		}
+	}
+
+	SlotList.Reset(NumFreeSlots);
+	for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+	{
+		for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
+		{
+			FInventoryItemSlot& Slot = SlotList.AddDefaulted_GetRef();
+			Slot.GroupTag = GroupTag;
+			Slot.SlotHandle = FInventorySlotHandle(RowIndex, ColumnIndex);
+
+			if (const FGameplayTagContainer* SlotTags = Config.SlotTagMap.Find(RowIndex * NumColumns + ColumnIndex))
+			{
+				Slot.SlotTags = *SlotTags;
+			}
+		}
+	}
+}
+
+bool FInventoryItemSlotGroup::IsValidSlot(const FInventorySlotHandle& SlotHandle) const
+{
+	return SlotHandle.RowIndex >= 0 && SlotHandle.RowIndex < NumRows &&
+		SlotHandle.ColumnIndex >= 0 && SlotHandle.ColumnIndex < NumColumns;
+}
+
+bool FInventoryItemSlotGroup::IsSlotFree(const FInventorySlotHandle& SlotHandle) const
+{
+	if (!IsValidSlot(SlotHandle))
+	{
+		return false;
+	}
+
+	return (RowOccupancy[SlotHandle.RowIndex] & (uint64(1) << SlotHandle.ColumnIndex)) == 0;
+}
+
+bool FInventoryItemSlotGroup::FindFirstFreeSlot(FInventorySlotHandle& OutSlotHandle) const
+{
+	for (int32 WordIndex = 0; WordIndex < RowsWithRoom.Num(); ++WordIndex)
+	{
+		const uint64 Rows = RowsWithRoom[WordIndex];
+		if (Rows == 0)
+		{
+			continue;
+		}
+
+		const int32 RowIndex = (WordIndex << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Rows));
+		const uint64 FreeBits = ~RowOccupancy[RowIndex] & ColumnMask;
+		check(FreeBits != 0);
+
+		OutSlotHandle = FInventorySlotHandle(RowIndex, static_cast<int32>(FMath::CountTrailingZeros64(FreeBits)));
+		return true;
+	}
+
+	OutSlotHandle.Reset();
+	return false;
+}
+
+bool FInventoryItemSlotGroup::FindFreeRun(int32 Length, FInventorySlotHandle& OutSlotHandle) const
+{
+	if (Length <= 1)
+	{
+		return FindFirstFreeSlot(OutSlotHandle);
+	}
+
+	if (Length <= NumColumns && Length <= NumFreeSlots)
+	{
+		for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+		{
+			const uint64 FreeBits = ~RowOccupancy[RowIndex] & ColumnMask;
+			if (const uint64 RunStarts = UE::ItemizationCore::SlotBits::MakeRunStartMask(FreeBits, Length))
+			{
+				OutSlotHandle = FInventorySlotHandle(RowIndex, static_cast<int32>(FMath::CountTrailingZeros64(RunStarts)));
+				return true;
+			}
+		}
+	}
+
+	OutSlotHandle.Reset();
+	return false;
+}
+
+bool FInventoryItemSlotGroup::OccupySlot(const FInventorySlotHandle& SlotHandle, const FInventoryItemHandle& ItemHandle)
+{
+	return PlaceItem(ItemHandle, SlotHandle, FInventorySlotFootprint());
+}
+
+bool FInventoryItemSlotGroup::ReleaseSlot(const FInventorySlotHandle& SlotHandle)
+{
+	if (!IsValidSlot(SlotHandle) || IsSlotFree(SlotHandle))
+	{
+		return false;
+	}
+
+	return RemoveItem(SlotList[GetSlotIndex(SlotHandle)].ItemHandle);
+}
+
+bool FInventoryItemSlotGroup::CanPlaceFootprint(
+	const FInventorySlotHandle& Origin,
+	const FInventorySlotFootprint& Footprint) const
+{
+	if (!IsValidSlot(Origin) || Footprint.Width <= 0 || Footprint.Height <= 0 ||
+		Origin.ColumnIndex + Footprint.Width > NumColumns ||
+		Origin.RowIndex + Footprint.Height > NumRows)
+	{
+		return false;
+	}
+
+	// One AND per covered row instead of testing every cell
+	const uint64 Mask = UE::ItemizationCore::SlotBits::MakeColumnMask(Origin.ColumnIndex, Footprint.Width);
+	for (int32 RowIndex = Origin.RowIndex; RowIndex < Origin.RowIndex + Footprint.Height; ++RowIndex)
+	{
+		if (RowOccupancy[RowIndex] & Mask)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FInventoryItemSlotGroup::FindFitForFootprint(
+	const FInventorySlotFootprint& Footprint,
+	FInventorySlotHandle& OutOrigin,
+	bool& bOutRotated) const
+{
+	bOutRotated = false;
+	if (FindFitForSize(Footprint.Width, Footprint.Height, OutOrigin))
+	{
+		return true;
+	}
+
+	// Square footprints look the same rotated
+	if (Footprint.bCanRotate && Footprint.Width != Footprint.Height &&
+		FindFitForSize(Footprint.Height, Footprint.Width, OutOrigin))
+	{
+		bOutRotated = true;
+		return true;
+	}
+
+	return false;
+}
+
+bool FInventoryItemSlotGroup::FindFitForSize(int32 Width, int32 Height, FInventorySlotHandle& OutOrigin) const
+{
+	OutOrigin.Reset();
+	
+	if (Width <= 0 || Height <= 0 || Width > NumColumns || Height > NumRows || Width * Height > NumFreeSlots)
+	{
+		return false;
+	}
+
+	// For every row, compute the columns at which a horizontal run of Width free slots starts
+	TArray<uint64, TInlineAllocator<64>> RunStarts;
+	RunStarts.SetNumUninitialized(NumRows);
+	for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+	{
+		RunStarts[RowIndex] = UE::ItemizationCore::SlotBits::MakeRunStartMask(~RowOccupancy[RowIndex] & ColumnMask, Width);
+	}
+
+	// Slide a window of Height rows down the grid. A column that survives the AND of all rows in the window is a fit.
+	for (int32 RowIndex = 0; RowIndex + Height <= NumRows; ++RowIndex)
+	{
+		uint64 Window = RunStarts[RowIndex];
+		for (int32 Offset = 1; Offset < Height && Window != 0; ++Offset)
+		{
+			Window &= RunStarts[RowIndex + Offset];
+		}
+
+		if (Window != 0)
+		{
+			OutOrigin = FInventorySlotHandle(RowIndex, static_cast<int32>(FMath::CountTrailingZeros64(Window)));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FInventoryItemSlotGroup::PlaceItem(
+	const FInventoryItemHandle& ItemHandle,
+	const FInventorySlotHandle& Origin,
+	const FInventorySlotFootprint& Footprint,
+	bool bRotated)
+{
+	if (!ItemHandle.IsValid() || FindPlacement(ItemHandle) != nullptr)
+	{
+		return false;
+	}
+	
+	if (!CanPlaceFootprint(Origin, bRotated ? Footprint.GetRotated() : Footprint))
+	{
+		return false;
+	}
+
+	FInventorySlotPlacement& Placement = Placements.AddDefaulted_GetRef();
+	Placement.ItemHandle = ItemHandle;
+	Placement.Origin = Origin;
+	Placement.Footprint = Footprint;
+	Placement.bRotated = bRotated;
+
+	SetPlacementOccupied(Placement, true);
+	return true;
+}
+
+bool FInventoryItemSlotGroup::PlaceItemAnywhere(
+	const FInventoryItemHandle& ItemHandle,
+	const FInventorySlotFootprint& Footprint,
+	FInventorySlotHandle* OutOrigin)
+{
+	FInventorySlotHandle Origin;
+	bool bRotated;
+	if (!FindFitForFootprint(Footprint, Origin, bRotated))
+	{
+		return false;
+	}
+
+	if (!PlaceItem(ItemHandle, Origin, Footprint, bRotated))
+	{
+		return false;
+	}
+
+	if (OutOrigin)
+	{
+		*OutOrigin = Origin;
+	}
+	return true;
+}
+
+bool FInventoryItemSlotGroup::RemoveItem(const FInventoryItemHandle& ItemHandle)
+{
+	const int32 PlacementIndex = Placements.IndexOfByPredicate([&ItemHandle](const FInventorySlotPlacement& Placement)
+	{
+		return Placement.ItemHandle == ItemHandle;
+	});
+
+	if (PlacementIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	SetPlacementOccupied(Placements[PlacementIndex], false);
+	Placements.RemoveAtSwap(PlacementIndex);
+	return true;
+}
+
+bool FInventoryItemSlotGroup::RotateItem(const FInventoryItemHandle& ItemHandle)
+{
+	FInventorySlotPlacement* Placement = Placements.FindByPredicate([&ItemHandle](const FInventorySlotPlacement& Other)
+	{
+		return Other.ItemHandle == ItemHandle;
+	});
+
+	if (Placement == nullptr || !Placement->Footprint.bCanRotate)
+	{
+		return false;
+	}
+
+	// Free our own slots first, so they don't block the rotated footprint
+	SetPlacementOccupied(*Placement, false);
+
+	const FInventorySlotFootprint Rotated = Placement->GetPlacedFootprint().GetRotated();
+	const bool bFits = CanPlaceFootprint(Placement->Origin, Rotated);
+	if (bFits)
+	{
+		Placement->bRotated = !Placement->bRotated;
+	}
+
+	SetPlacementOccupied(*Placement, true);
+	return bFits;
+}
+
+bool FInventoryItemSlotGroup::AutoPack()
+{
+	if (Placements.IsEmpty())
+	{
+		return true;
+	}
+	
+	// Keep the old layout around in case the greedy packing fails
+	const TArray<FInventorySlotPlacement> OldPlacements = Placements;
+
+	// Larger footprints first, taller ones first on ties, to leave as few holes as possible
+	TArray<FInventorySlotPlacement> ToPlace = Placements;
+	Algo::StableSort(ToPlace, [](const FInventorySlotPlacement& A, const FInventorySlotPlacement& B)
+	{
+		const int32 AreaA = A.Footprint.GetArea();
+		const int32 AreaB = B.Footprint.GetArea();
+		if (AreaA != AreaB)
+		{
+			return AreaA > AreaB;
+		}
+		return FMath::Max(A.Footprint.Width, A.Footprint.Height) > FMath::Max(B.Footprint.Width, B.Footprint.Height);
+	});
+
+	for (const FInventorySlotPlacement& Placement : OldPlacements)
+	{
+		SetPlacementOccupied(Placement, false);
+	}
+	Placements.Reset();
+
+	for (const FInventorySlotPlacement& Placement : ToPlace)
+	{
+		if (!PlaceItemAnywhere(Placement.ItemHandle, Placement.Footprint))
+		{
+			// Restore the previous layout
+			for (const FInventorySlotPlacement& NewPlacement : Placements)
+			{
+				SetPlacementOccupied(NewPlacement, false);
+			}
+
+			Placements = OldPlacements;
+			for (const FInventorySlotPlacement& OldPlacement : Placements)
+			{
+				SetPlacementOccupied(OldPlacement, true);
+			}
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const FInventorySlotPlacement* FInventoryItemSlotGroup::FindPlacement(const FInventoryItemHandle& ItemHandle) const
+{
+	return Placements.FindByPredicate([&ItemHandle](const FInventorySlotPlacement& Placement)
+	{
+		return Placement.ItemHandle == ItemHandle;
+	});
+}
+
+const FInventoryItemSlot* FInventoryItemSlotGroup::FindSlot(const FInventorySlotHandle& SlotHandle) const
+{
+	const int32 SlotIndex = GetSlotIndex(SlotHandle);
+	return SlotList.IsValidIndex(SlotIndex) ? &SlotList[SlotIndex] : nullptr;
+}
+
+void FInventoryItemSlotGroup::SetPlacementOccupied(const FInventorySlotPlacement& Placement, bool bOccupied)
+{
+	const FInventorySlotFootprint Footprint = Placement.GetPlacedFootprint();
+	const FInventorySlotHandle& Origin = Placement.Origin;
+	const uint64 Mask = UE::ItemizationCore::SlotBits::MakeColumnMask(Origin.ColumnIndex, Footprint.Width);
+
+	for (int32 RowIndex = Origin.RowIndex; RowIndex < Origin.RowIndex + Footprint.Height; ++RowIndex)
+	{
+		SetRowOccupied(RowIndex, Mask, bOccupied);
+
+		const int32 FirstSlotIndex = RowIndex * NumColumns + Origin.ColumnIndex;
+		for (int32 SlotIndex = FirstSlotIndex; SlotIndex < FirstSlotIndex + Footprint.Width; ++SlotIndex)
+		{
+			if (bOccupied)
+			{
+				SlotList[SlotIndex].ItemHandle = Placement.ItemHandle;
+			}
+			else
+			{
+				SlotList[SlotIndex].ItemHandle.Reset();
+			}
+		}
+	}
+}
+
+void FInventoryItemSlotGroup::SetRowOccupied(int32 RowIndex, uint64 ColumnBits, bool bOccupied)
+{
+	uint64& Row = RowOccupancy[RowIndex];
+	const uint64 OldRow = Row;
+	
+	if (bOccupied)
+	{
+		Row |= ColumnBits;
+	}
+	else
+	{
+		Row &= ~ColumnBits;
+	}
+
+	NumFreeSlots -= FMath::CountBits(Row) - FMath::CountBits(OldRow);
+
+	// Keep the summary bit in sync, so full rows are skipped without looking at them
+	const uint64 RowBit = uint64(1) << (RowIndex & 63);
+	if ((Row & ColumnMask) == ColumnMask)
+	{
+		RowsWithRoom[RowIndex >> 6] &= ~RowBit;
+	}
+	else
+	{
+		RowsWithRoom[RowIndex >> 6] |= RowBit;
+	}
+}
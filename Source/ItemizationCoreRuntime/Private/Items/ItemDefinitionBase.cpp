@@ -3,8 +3,10 @@
 
 #include "Items/ItemDefinitionBase.h"
 
+#include "Inventory/InventoryRoutingTable.h"
 #include "Items/InventoryItemInstance.h"
 #include "Items/Data/ItemComponentData.h"
+#include "Items/Data/ItemComponentData_Traits.h"
 
 
 UItemDefinitionBase::UItemDefinitionBase(const FObjectInitializer& ObjectInitializer)
@@ -41,3 +43,23 @@ const FItemComponentData* UItemDefinitionBase::GetItemData(const UScriptStruct*
 
 	return nullptr;
 }
+
+void UItemDefinitionBase::PostLoad()
+{
+	Super::PostLoad();
+
+	// Assign trait bits up front, so snapshots and worker queries never see a trait without its bit
+	FItemComponentData_Traits::RegisterTraitBits(this);
+}
+
+#if WITH_EDITOR
+void UItemDefinitionBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	FItemComponentData_Traits::RegisterTraitBits(this);
+
+	// Traits might have changed, so cached routing results are stale
+	FInventoryRoutingTable::InvalidateAll();
+}
+#endif
@@ -0,0 +1,51 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LatentActions.h"
+#include "Engine/LatentActionManager.h"
+#include "Transactions/InventoryOpHandle.h"
+
+/** Latent action that finishes once the inventory op it is waiting on has completed. */
+template <typename OpType>
+class TInventoryOpLatentAction : public FPendingLatentAction
+{
+public:
+	using FResultCallback = TUniqueFunction<void(const TInventoryTransactionResult<OpType>&)>;
+
+	TInventoryOpLatentAction(const FLatentActionInfo& LatentInfo, TInventoryOpHandle<OpType>&& InOpHandle, FResultCallback&& InResultCallback)
+		: ExecutionFunction(LatentInfo.ExecutionFunction)
+		, OutputLink(LatentInfo.Linkage)
+		, CallbackTarget(LatentInfo.CallbackTarget)
+		, OpHandle(MoveTemp(InOpHandle))
+		, ResultCallback(MoveTemp(InResultCallback))
+	{
+	}
+
+	//~ Begin FPendingLatentAction Interface
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		if (const TInventoryTransactionResult<OpType>* Result = OpHandle.TryGetResult())
+		{
+			ResultCallback(*Result);
+			Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+		}
+	}
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override
+	{
+		return FString::Printf(TEXT("Waiting for inventory op '%s'"), OpType::Name);
+	}
+#endif
+	//~ End FPendingLatentAction Interface
+
+private:
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+
+	TInventoryOpHandle<OpType> OpHandle;
+	FResultCallback ResultCallback;
+};
\ No newline at end of file
@@ -3,8 +3,16 @@
 
 #include "Libraries/ItemizationInventoryLibrary.h"
 
+#include "Libraries/InventoryOpLatentAction.h"
+#include "ItemizationGameplayTags.h"
+#include "ItemizationLogChannels.h"
+#include "Components/InventoryComponent.h"
+#include "DelayAction.h"
+#include "Engine/Engine.h"
 #include "Interfaces/InventoryOwnerInterface.h"
 #include "Inventory/InventoryBase.h"
+#include "Inventory/InventoryDefinition.h"
+#include "Items/Data/ItemComponentData_Traits.h"
 #include "Transactions/InventoryTransaction_GiveRemoveItem.h"
 
 FInventoryItemHandle UItemizationInventoryLibrary::GiveItem(
@@ -26,6 +34,282 @@ FInventoryItemHandle UItemizationInventoryLibrary::GiveItem(
 	return FInventoryItemHandle();
 }
 
+FInventoryRoutedGiveResult UItemizationInventoryLibrary::GiveItemRouted(
+	AActor* InventoryOwner,
+	const UInventoryDefinition* InventoryDefinition,
+	UItemDefinitionBase* ItemDefinition,
+	int32 StackCount)
+{
+	FInventoryRoutedGiveResult Result;
+	Result.Excess = FMath::Max(StackCount, 0);
+
+	if (!IsValid(InventoryOwner) || !InventoryDefinition || !ItemDefinition || Result.Excess == 0)
+	{
+		return Result;
+	}
+
+	if (!InventoryOwner->HasAuthority())
+	{
+		ITEMIZATION_WARN("GiveItemRouted called without authority over %s.", *GetNameSafe(InventoryOwner));
+		return Result;
+	}
+
+	TArray<AInventoryBase*, TInlineAllocator<8>> Inventories;
+	FindRoutedInventories(InventoryOwner, InventoryDefinition, Inventories);
+
+	// Sort the accepting inventories into regular, overflow and those that already hold the item
+	const uint64 AcceptingMask = InventoryDefinition->GetAcceptingInventories(ItemDefinition);
+	uint64 RegularMask = 0;
+	uint64 OverflowMask = 0;
+	uint64 HoldingMask = 0;
+	for (int32 Index = 0; Index < Inventories.Num(); ++Index)
+	{
+		const uint64 Bit = uint64(1) << Index;
+		if ((AcceptingMask & Bit) == 0 || Inventories[Index] == nullptr)
+		{
+			continue;
+		}
+
+		if (InventoryDefinition->GetInventoryProperties(Index)->bIsOverflow)
+		{
+			OverflowMask |= Bit;
+		}
+		else
+		{
+			RegularMask |= Bit;
+		}
+
+		if (Inventories[Index]->GetTotalCount(ItemDefinition) > 0)
+		{
+			HoldingMask |= Bit;
+		}
+	}
+
+	// Regular inventories come first, overflow inventories only take what is left
+	uint64 Passes[2] = { RegularMask, OverflowMask };
+	if (FItemComponentData_Traits::HasTrait(ItemDefinition, Itemization::Tags::TAG_ItemTrait_ForceIntoOverflow))
+	{
+		Passes[0] = OverflowMask;
+		Passes[1] = 0;
+	}
+	else if ((OverflowMask & HoldingMask) != 0 &&
+		FItemComponentData_Traits::HasTrait(ItemDefinition, Itemization::Tags::TAG_ItemTrait_ForceStayInOverflow))
+	{
+		Passes[0] = OverflowMask;
+		Passes[1] = RegularMask;
+	}
+
+	for (const uint64 PassMask : Passes)
+	{
+		// Fill up inventories with existing stacks before opening new stacks anywhere else
+		const uint64 OrderedMasks[2] = { PassMask & HoldingMask, PassMask & ~HoldingMask };
+		for (const uint64 OrderedMask : OrderedMasks)
+		{
+			for (uint64 Remaining = OrderedMask; Remaining != 0 && Result.Excess > 0; Remaining &= Remaining - 1)
+			{
+				const int32 Index = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+				AInventoryBase* Inventory = Inventories[Index];
+
+				FInventoryItemEntry ItemEntry(ItemDefinition, Result.Excess, InventoryOwner);
+				FInventoryTransaction_GiveRemoveItem Transaction(nullptr, Inventory, Result.Excess);
+
+				int32 Excess = 0;
+				const FInventoryItemHandle ItemHandle = Inventory->GiveItem(ItemEntry, Excess, Transaction);
+
+				const int32 Given = Result.Excess - Excess;
+				if (Given > 0)
+				{
+					FInventoryRoutedGiveEntry& Entry = Result.Entries.AddDefaulted_GetRef();
+					Entry.Inventory = Inventory;
+					Entry.ItemHandle = ItemHandle;
+					Entry.Count = Given;
+					Result.Excess = Excess;
+				}
+			}
+		}
+	}
+
+	return Result;
+}
+
+void UItemizationInventoryLibrary::FindRoutedInventories(
+	const AActor* InventoryOwner,
+	const UInventoryDefinition* InventoryDefinition,
+	TArray<AInventoryBase*, TInlineAllocator<8>>& OutInventories)
+{
+	TArray<UActorComponent*, TInlineAllocator<8>> Components;
+	FindRoutedComponents(InventoryOwner, InventoryDefinition, Components);
+
+	OutInventories.Reset();
+	OutInventories.SetNumZeroed(Components.Num());
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		if (const IInventoryOwnerInterface* InventoryComponent = Cast<IInventoryOwnerInterface>(Components[Index]))
+		{
+			OutInventories[Index] = InventoryComponent->GetInventory();
+		}
+	}
+}
+
+void UItemizationInventoryLibrary::FindRoutedComponents(
+	const AActor* InventoryOwner,
+	const UInventoryDefinition* InventoryDefinition,
+	TArray<UActorComponent*, TInlineAllocator<8>>& OutComponents)
+{
+	OutComponents.Reset();
+	if (!InventoryOwner || !InventoryDefinition)
+	{
+		return;
+	}
+
+	const int32 NumInventories = FMath::Min(InventoryDefinition->GetNumInventories(), FInventoryRoutingTable::MaxNumInventories);
+	OutComponents.SetNumZeroed(NumInventories);
+
+	// Each component can only back a single inventory. Multiple inventories of the same class are mapped in order
+	TArray<UActorComponent*, TInlineAllocator<8>> Components;
+	for (UActorComponent* Component : InventoryOwner->GetComponents())
+	{
+		if (Cast<IInventoryOwnerInterface>(Component))
+		{
+			Components.Add(Component);
+		}
+	}
+
+	for (int32 Index = 0; Index < NumInventories; ++Index)
+	{
+		const UClass* ComponentClass = Index < InventoryDefinition->InventoryList.Num()
+			? InventoryDefinition->InventoryList[Index].InventoryComponent.Get()
+			: InventoryDefinition->EquippableInventoryList[Index - InventoryDefinition->InventoryList.Num()].InventoryComponent.Get();
+		if (ComponentClass == nullptr)
+		{
+			continue;
+		}
+
+		const int32 ComponentIdx = Components.IndexOfByPredicate([ComponentClass](const UActorComponent* Component)
+		{
+			return Component && Component->IsA(ComponentClass);
+		});
+
+		if (Components.IsValidIndex(ComponentIdx))
+		{
+			OutComponents[Index] = Components[ComponentIdx];
+			Components[ComponentIdx] = nullptr;
+		}
+	}
+}
+
+void UItemizationInventoryLibrary::ApplyInventoryDefinition(AActor* InventoryOwner, const UInventoryDefinition* InventoryDefinition)
+{
+	TArray<UActorComponent*, TInlineAllocator<8>> Components;
+	FindRoutedComponents(InventoryOwner, InventoryDefinition, Components);
+
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		if (UInventoryComponent* InventoryComponent = Cast<UInventoryComponent>(Components[Index]))
+		{
+			InventoryComponent->SetInventoryDefinition(InventoryDefinition, Index);
+		}
+	}
+}
+
+void UItemizationInventoryLibrary::GiveItemAndWait(
+	UObject* WorldContextObject,
+	FLatentActionInfo LatentInfo,
+	AInventoryBase* Inventory,
+	UItemDefinitionBase* ItemDefinition,
+	int32 StackCount,
+	FInventoryItemHandle& ItemHandle,
+	int32& Excess,
+	bool& bSuccess)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	FLatentActionManager& LatentManager = World->GetLatentActionManager();
+	if (LatentManager.FindExistingAction<TInventoryOpLatentAction<FInventoryItemGiveOp>>(LatentInfo.CallbackTarget, LatentInfo.UUID)
+		|| LatentManager.FindExistingAction<FDelayUntilNextTickAction>(LatentInfo.CallbackTarget, LatentInfo.UUID))
+	{
+		return;
+	}
+
+	if (!IsValid(Inventory))
+	{
+		// Still continue the graph, otherwise it would wait forever
+		ItemHandle = FInventoryItemHandle();
+		Excess = 0;
+		bSuccess = false;
+		LatentManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new FDelayUntilNextTickAction(LatentInfo));
+		return;
+	}
+
+	FInventoryItemGiveOp::Params Params;
+	Params.ItemDefinition = ItemDefinition;
+	Params.StackCount = StackCount;
+	Params.SourceObject = WorldContextObject;
+
+	LatentManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new TInventoryOpLatentAction<FInventoryItemGiveOp>(
+		LatentInfo, Inventory->EnqueueGiveItem(MoveTemp(Params)),
+		[&ItemHandle, &Excess, &bSuccess](const TInventoryTransactionResult<FInventoryItemGiveOp>& Result)
+		{
+			bSuccess = Result.IsOk();
+			ItemHandle = bSuccess ? Result.GetOkValue().ItemHandle : FInventoryItemHandle();
+			Excess = bSuccess ? Result.GetOkValue().Excess : 0;
+		}));
+}
+
+void UItemizationInventoryLibrary::MoveItemAndWait(
+	UObject* WorldContextObject,
+	FLatentActionInfo LatentInfo,
+	AInventoryBase* SourceInventory,
+	AInventoryBase* TargetInventory,
+	FInventoryItemHandle ItemHandle,
+	int32 Delta,
+	FInventoryItemHandle& TargetItemHandle,
+	int32& Excess,
+	bool& bSuccess)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	FLatentActionManager& LatentManager = World->GetLatentActionManager();
+	if (LatentManager.FindExistingAction<TInventoryOpLatentAction<FInventoryItemMoveOp>>(LatentInfo.CallbackTarget, LatentInfo.UUID)
+		|| LatentManager.FindExistingAction<FDelayUntilNextTickAction>(LatentInfo.CallbackTarget, LatentInfo.UUID))
+	{
+		return;
+	}
+
+	if (!IsValid(SourceInventory) || !IsValid(TargetInventory))
+	{
+		// Still continue the graph, otherwise it would wait forever
+		TargetItemHandle = FInventoryItemHandle();
+		Excess = 0;
+		bSuccess = false;
+		LatentManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new FDelayUntilNextTickAction(LatentInfo));
+		return;
+	}
+
+	FInventoryItemMoveOp::Params Params;
+	Params.SourceInventory = SourceInventory;
+	Params.TargetInventory = TargetInventory;
+	Params.ItemHandle = ItemHandle;
+	Params.Delta = Delta;
+
+	LatentManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new TInventoryOpLatentAction<FInventoryItemMoveOp>(
+		LatentInfo, SourceInventory->MoveItem(MoveTemp(Params)),
+		[&TargetItemHandle, &Excess, &bSuccess](const TInventoryTransactionResult<FInventoryItemMoveOp>& Result)
+		{
+			bSuccess = Result.IsOk();
+			TargetItemHandle = bSuccess ? Result.GetOkValue().TargetItemHandle : FInventoryItemHandle();
+			Excess = bSuccess ? Result.GetOkValue().Excess : 0;
+		}));
+}
+
 void UItemizationInventoryLibrary::PerformTransaction(
 	TScriptInterface<IInventoryOwnerInterface> InventoryOwner,
 	FInventoryTrackableOp& Transaction)
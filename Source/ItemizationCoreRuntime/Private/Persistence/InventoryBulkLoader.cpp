@@ -0,0 +1,197 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Persistence/InventoryBulkLoader.h"
+
+#include "ItemizationLogChannels.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+FInventoryBulkLoader::FInventoryBulkLoader(bool bDeferInstances)
+{
+	LoadContext.bDeferInstances = bDeferInstances;
+}
+
+FInventoryBulkLoader::~FInventoryBulkLoader()
+{
+	Close();
+}
+
+bool FInventoryBulkLoader::WritePackedFile(const FString& FilePath, TConstArrayView<TPair<FString, const AInventoryBase*>> Inventories)
+{
+	check(IsInGameThread());
+
+	TArray<TArray<uint8>> Saves;
+	Saves.Reserve(Inventories.Num());
+
+	FInventorySaveData Data;
+	for (const TPair<FString, const AInventoryBase*>& Pair : Inventories)
+	{
+		FInventorySerializer::Capture(*Pair.Value, Data);
+		FInventorySerializer::Encode(Data, Saves.AddDefaulted_GetRef());
+	}
+
+	// Offsets and sizes have a fixed width, so writing the index twice yields the same size with the real offsets
+	TArray<uint8> Header;
+	uint64 DataOffset = 0;
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		Header.Reset();
+		FMemoryWriter Ar(Header);
+
+		uint32 MagicValue = PackMagic;
+		uint16 Version = PackVersion;
+		int32 NumInventories = Inventories.Num();
+		Ar << MagicValue;
+		Ar << Version;
+		Ar << NumInventories;
+
+		uint64 Offset = DataOffset;
+		for (int32 Idx = 0; Idx < Inventories.Num(); ++Idx)
+		{
+			FString Key = Inventories[Idx].Key;
+			uint32 Size = Saves[Idx].Num();
+			Ar << Key;
+			Ar << Offset;
+			Ar << Size;
+			Offset += Size;
+		}
+
+		DataOffset = Header.Num();
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	Writer->Serialize(Header.GetData(), Header.Num());
+	for (TArray<uint8>& Save : Saves)
+	{
+		Writer->Serialize(Save.GetData(), Save.Num());
+	}
+
+	return Writer->Close();
+}
+
+bool FInventoryBulkLoader::Open(const FString& FilePath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+	if (!MappedHandle)
+	{
+		ITEMIZATION_WARN("Failed to map packed inventory file %s.", *FilePath);
+		return false;
+	}
+
+	const int64 FileSize = MappedHandle->GetFileSize();
+	if (FileSize <= 0 || FileSize > MAX_int32)
+	{
+		ITEMIZATION_WARN("Packed inventory file %s has an unsupported size of %lld bytes.", *FilePath, FileSize);
+		Close();
+		return false;
+	}
+
+	MappedRegion.Reset(MappedHandle->MapRegion(0, FileSize));
+	if (!MappedRegion)
+	{
+		Close();
+		return false;
+	}
+
+	const TConstArrayView<uint8> Mapped(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	FMemoryReaderView Ar(Mapped);
+
+	uint32 MagicValue = 0;
+	uint16 Version = 0;
+	int32 NumInventories = 0;
+	Ar << MagicValue;
+	Ar << Version;
+	Ar << NumInventories;
+
+	// Every index entry takes at least one byte, which bounds the allocation for corrupted files
+	if (Ar.IsError() || MagicValue != PackMagic || Version != PackVersion || NumInventories < 0 || NumInventories > Mapped.Num())
+	{
+		ITEMIZATION_WARN("Failed to open packed inventory file %s: unknown format.", *FilePath);
+		Close();
+		return false;
+	}
+
+	Index.Reserve(NumInventories);
+	for (int32 Idx = 0; Idx < NumInventories && !Ar.IsError(); ++Idx)
+	{
+		FString Key;
+		FIndexEntry Entry;
+		Ar << Key;
+		Ar << Entry.Offset;
+		Ar << Entry.Size;
+
+		// Offset + Size could overflow for corrupted entries, so check them separately
+		const uint64 MappedSize = static_cast<uint64>(Mapped.Num());
+		if (Entry.Offset > MappedSize || Entry.Size > MappedSize - Entry.Offset)
+		{
+			Ar.SetError();
+			break;
+		}
+
+		Index.Add(MoveTemp(Key), Entry);
+	}
+
+	if (Ar.IsError())
+	{
+		ITEMIZATION_WARN("Failed to open packed inventory file %s: the index is corrupted.", *FilePath);
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void FInventoryBulkLoader::Close()
+{
+	// The region has to go before the handle it has been mapped from
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	Index.Reset();
+}
+
+bool FInventoryBulkLoader::Restore(const FString& Key, AInventoryBase& Inventory)
+{
+	const FIndexEntry* Entry = Index.Find(Key);
+	if (Entry == nullptr || !MappedRegion)
+	{
+		return false;
+	}
+
+	const TConstArrayView<uint8> Save(MappedRegion->GetMappedPtr() + Entry->Offset, static_cast<int32>(Entry->Size));
+	return FInventorySerializer::Load(Inventory, Save, &LoadContext);
+}
+
+int32 FInventoryBulkLoader::RestoreAll(TFunctionRef<AInventoryBase*(const FString& Key)> ResolveInventory)
+{
+	int32 NumRestored = 0;
+	for (const TPair<FString, FIndexEntry>& Pair : Index)
+	{
+		AInventoryBase* Inventory = ResolveInventory(Pair.Key);
+		if (Inventory && Restore(Pair.Key, *Inventory))
+		{
+			++NumRestored;
+		}
+	}
+
+	ITEMIZATION_VERBOSE("Restored %d of %d packed inventories, %d item instances deferred.",
+		NumRestored, Index.Num(), LoadContext.DeferredInstances.Num() - LoadContext.NextDeferredInstance);
+
+	return NumRestored;
+}
+
+int32 FInventoryBulkLoader::CreateDeferredInstances(double MaxSeconds)
+{
+	return FInventorySerializer::CreateDeferredInstances(LoadContext, MaxSeconds);
+}
@@ -0,0 +1,233 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Persistence/InventoryHandoff.h"
+
+#include "ItemizationLogChannels.h"
+#include "Inventory/InventoryBase.h"
+#include "Items/InventoryItemSlot.h"
+#include "Persistence/InventorySaveData.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace UE::ItemizationCore::Handoff
+{
+	/** Flags of a single slot placement. */
+	enum class EPlacementFlags : uint8
+	{
+		None = 0,
+		CanRotate = 1 << 0,
+		Rotated = 1 << 1,
+	};
+	ENUM_CLASS_FLAGS(EPlacementFlags)
+
+	/** Writes a section header followed by the payload. */
+	static void WriteSection(FArchive& Ar, EInventoryHandoffSection Section, TArray<uint8>& Payload)
+	{
+		uint8 SectionId = static_cast<uint8>(Section);
+		uint32 Size = Payload.Num();
+		Ar << SectionId;
+		Ar.SerializeIntPacked(Size);
+		Ar.Serialize(Payload.GetData(), Payload.Num());
+	}
+
+	static void WriteSlotGroups(FArchive& Ar, TConstArrayView<const FInventoryItemSlotGroup*> SlotGroups)
+	{
+		uint32 NumGroups = SlotGroups.Num();
+		Ar.SerializeIntPacked(NumGroups);
+
+		for (const FInventoryItemSlotGroup* Group : SlotGroups)
+		{
+			FString GroupTag = Group->GroupTag.ToString();
+			uint32 NumRows = Group->NumRows;
+			uint32 NumColumns = Group->NumColumns;
+			uint32 NumPlacements = Group->Placements.Num();
+			Ar << GroupTag;
+			Ar.SerializeIntPacked(NumRows);
+			Ar.SerializeIntPacked(NumColumns);
+			Ar.SerializeIntPacked(NumPlacements);
+
+			for (const FInventorySlotPlacement& Placement : Group->Placements)
+			{
+				uint32 ItemHandle = Placement.ItemHandle.Get();
+				uint32 RowIndex = Placement.Origin.RowIndex;
+				uint32 ColumnIndex = Placement.Origin.ColumnIndex;
+				uint32 Width = Placement.Footprint.Width;
+				uint32 Height = Placement.Footprint.Height;
+
+				EPlacementFlags Flags = EPlacementFlags::None;
+				Flags |= Placement.Footprint.bCanRotate ? EPlacementFlags::CanRotate : EPlacementFlags::None;
+				Flags |= Placement.bRotated ? EPlacementFlags::Rotated : EPlacementFlags::None;
+				uint8 FlagBits = static_cast<uint8>(Flags);
+
+				Ar.SerializeIntPacked(ItemHandle);
+				Ar.SerializeIntPacked(RowIndex);
+				Ar.SerializeIntPacked(ColumnIndex);
+				Ar.SerializeIntPacked(Width);
+				Ar.SerializeIntPacked(Height);
+				Ar << FlagBits;
+			}
+		}
+	}
+
+	static bool ReadSlotGroups(FArchive& Ar, const AInventoryBase& Inventory, TFunctionRef<FInventoryItemSlotGroup*(const FGameplayTag&)> FindSlotGroup)
+	{
+		uint32 NumGroups = 0;
+		Ar.SerializeIntPacked(NumGroups);
+
+		for (uint32 GroupIdx = 0; GroupIdx < NumGroups && !Ar.IsError(); ++GroupIdx)
+		{
+			FString GroupTag;
+			uint32 NumRows = 0;
+			uint32 NumColumns = 0;
+			uint32 NumPlacements = 0;
+			Ar << GroupTag;
+			Ar.SerializeIntPacked(NumRows);
+			Ar.SerializeIntPacked(NumColumns);
+			Ar.SerializeIntPacked(NumPlacements);
+
+			FInventoryItemSlotGroup* Group = FindSlotGroup(FGameplayTag::RequestGameplayTag(FName(*GroupTag), false));
+			if (Group && (Group->NumRows != static_cast<int32>(NumRows) || Group->NumColumns != static_cast<int32>(NumColumns)))
+			{
+				ITEMIZATION_WARN("Slot group %s of inventory %s changed its size from %ux%u to %dx%d, re-placing the handed over items.",
+					*GroupTag, *GetNameSafe(&Inventory), NumRows, NumColumns, Group->NumRows, Group->NumColumns);
+			}
+
+			for (uint32 PlacementIdx = 0; PlacementIdx < NumPlacements && !Ar.IsError(); ++PlacementIdx)
+			{
+				uint32 ItemHandle = 0;
+				uint32 RowIndex = 0;
+				uint32 ColumnIndex = 0;
+				uint32 Width = 0;
+				uint32 Height = 0;
+				uint8 FlagBits = 0;
+				Ar.SerializeIntPacked(ItemHandle);
+				Ar.SerializeIntPacked(RowIndex);
+				Ar.SerializeIntPacked(ColumnIndex);
+				Ar.SerializeIntPacked(Width);
+				Ar.SerializeIntPacked(Height);
+				Ar << FlagBits;
+
+				// Only place items that made it into the inventory
+				const FInventoryItemHandle Handle = FInventoryItemHandle::FromRaw(ItemHandle);
+				if (Group == nullptr || Inventory.FindItemEntryFromHandle(Handle) == nullptr)
+				{
+					continue;
+				}
+
+				const EPlacementFlags Flags = static_cast<EPlacementFlags>(FlagBits);
+				const FInventorySlotFootprint Footprint(static_cast<int32>(Width), static_cast<int32>(Height), EnumHasAnyFlags(Flags, EPlacementFlags::CanRotate));
+				const FInventorySlotHandle Origin(static_cast<int32>(RowIndex), static_cast<int32>(ColumnIndex));
+
+				if (!Group->PlaceItem(Handle, Origin, Footprint, EnumHasAnyFlags(Flags, EPlacementFlags::Rotated)) &&
+					!Group->PlaceItemAnywhere(Handle, Footprint))
+				{
+					ITEMIZATION_WARN("No room left for item [%s] in slot group %s of inventory %s after the handoff.",
+						*Handle.ToString(), *GroupTag, *GetNameSafe(&Inventory));
+				}
+			}
+		}
+
+		return !Ar.IsError();
+	}
+}
+
+void FInventoryHandoff::Export(const AInventoryBase& Inventory, TConstArrayView<const FInventoryItemSlotGroup*> SlotGroups, TArray<uint8>& OutBytes)
+{
+	using namespace UE::ItemizationCore::Handoff;
+	check(IsInGameThread());
+
+	OutBytes.Reset();
+	FMemoryWriter Ar(OutBytes);
+
+	uint32 MagicValue = Magic;
+	uint16 VersionValue = Version;
+	Ar << MagicValue;
+	Ar << VersionValue;
+
+	// Transient items are part of the live inventory and have to move with the player, and so does the whole instance state
+	FInventorySaveData Data;
+	FInventorySerializer::Capture(Inventory, Data, true, true);
+
+	TArray<uint8> Payload;
+	FInventorySerializer::Encode(Data, Payload);
+	WriteSection(Ar, EInventoryHandoffSection::Inventory, Payload);
+
+	if (!SlotGroups.IsEmpty())
+	{
+		Payload.Reset();
+		FMemoryWriter GroupWriter(Payload);
+		WriteSlotGroups(GroupWriter, SlotGroups);
+		WriteSection(Ar, EInventoryHandoffSection::SlotGroups, Payload);
+	}
+}
+
+bool FInventoryHandoff::Import(AInventoryBase& Inventory, TConstArrayView<uint8> Bytes, TFunctionRef<FInventoryItemSlotGroup*(const FGameplayTag&)> FindSlotGroup)
+{
+	using namespace UE::ItemizationCore::Handoff;
+	check(IsInGameThread());
+
+	FMemoryReaderView Ar(Bytes);
+
+	uint32 MagicValue = 0;
+	uint16 VersionValue = 0;
+	Ar << MagicValue;
+	Ar << VersionValue;
+
+	if (Ar.IsError() || MagicValue != Magic || VersionValue == 0 || VersionValue > Version)
+	{
+		ITEMIZATION_WARN("Failed to import inventory %s: unknown handoff format (magic 0x%08X, version %d).",
+			*GetNameSafe(&Inventory), MagicValue, VersionValue);
+		return false;
+	}
+
+	// Items have to be restored before they can be placed, so collect the sections first
+	TConstArrayView<uint8> Sections[2];
+	while (!Ar.AtEnd() && !Ar.IsError())
+	{
+		uint8 SectionId = 0;
+		uint32 Size = 0;
+		Ar << SectionId;
+		Ar.SerializeIntPacked(Size);
+
+		const int64 Offset = Ar.Tell();
+		if (Size > Bytes.Num() - Offset)
+		{
+			Ar.SetError();
+			break;
+		}
+
+		if (SectionId >= static_cast<uint8>(EInventoryHandoffSection::Inventory) && SectionId <= UE_ARRAY_COUNT(Sections))
+		{
+			Sections[SectionId - 1] = Bytes.Slice(static_cast<int32>(Offset), static_cast<int32>(Size));
+		}
+
+		Ar.Seek(Offset + Size);
+	}
+
+	const TConstArrayView<uint8>& InventorySection = Sections[static_cast<uint8>(EInventoryHandoffSection::Inventory) - 1];
+	if (Ar.IsError() || InventorySection.IsEmpty())
+	{
+		ITEMIZATION_WARN("Failed to import inventory %s: the handoff is corrupted.", *GetNameSafe(&Inventory));
+		return false;
+	}
+
+	FInventoryLoadContext LoadContext;
+	LoadContext.bFullInstanceState = true;
+	if (!FInventorySerializer::Load(Inventory, InventorySection, &LoadContext))
+	{
+		return false;
+	}
+
+	const TConstArrayView<uint8>& SlotGroupSection = Sections[static_cast<uint8>(EInventoryHandoffSection::SlotGroups) - 1];
+	if (!SlotGroupSection.IsEmpty())
+	{
+		FMemoryReaderView GroupReader(SlotGroupSection);
+		if (!ReadSlotGroups(GroupReader, Inventory, FindSlotGroup))
+		{
+			ITEMIZATION_WARN("Slot layout of inventory %s couldn't be fully restored, the handoff is corrupted.", *GetNameSafe(&Inventory));
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,339 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Persistence/InventoryJournal.h"
+
+#include "InventoryPersistenceUtils.h"
+#include "ItemizationCoreSettings.h"
+#include "ItemizationLogChannels.h"
+#include "HAL/FileManager.h"
+#include "Inventory/InventoryBase.h"
+#include "Items/Data/ItemComponentData_Traits.h"
+#include "Misc/FileHelper.h"
+#include "Persistence/InventorySaveData.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace UE::ItemizationCore::Persistence
+{
+	/** Type of a single journal record. */
+	enum class EJournalRecordType : uint8
+	{
+		/** The entry has been added or changed. Carries the full state of the entry. */
+		Upsert = 0,
+
+		/** The entry has been removed. Only carries the handle. */
+		Remove = 1,
+	};
+
+	/** Every flushed block starts with its size and checksum, so torn writes at the end of the tail can be detected. */
+	struct FJournalBlockHeader
+	{
+		uint32 Size = 0;
+		uint32 Crc = 0;
+	};
+}
+
+FInventoryFileJournalBackend::FInventoryFileJournalBackend(const FString& InBasePath)
+	: SnapshotPath(InBasePath + TEXT(".snap"))
+	, TailPath(InBasePath + TEXT(".wal"))
+{
+}
+
+bool FInventoryFileJournalBackend::Append(TConstArrayView<uint8> Block)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TailPath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	Writer->Serialize(const_cast<uint8*>(Block.GetData()), Block.Num());
+	Writer->Flush();
+	return Writer->Close();
+}
+
+bool FInventoryFileJournalBackend::ReadTail(TArray<uint8>& OutTail)
+{
+	OutTail.Reset();
+	return !IFileManager::Get().FileExists(*TailPath) || FFileHelper::LoadFileToArray(OutTail, *TailPath);
+}
+
+bool FInventoryFileJournalBackend::WriteSnapshot(TConstArrayView<uint8> Snapshot)
+{
+	// Write to a temporary file first, so a crash while writing never leaves us without a valid snapshot
+	const FString TempPath = SnapshotPath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Snapshot, *TempPath) ||
+		!IFileManager::Get().Move(*SnapshotPath, *TempPath, true, true))
+	{
+		return false;
+	}
+
+	return IFileManager::Get().Delete(*TailPath, false, true, true) || !IFileManager::Get().FileExists(*TailPath);
+}
+
+bool FInventoryFileJournalBackend::ReadSnapshot(TArray<uint8>& OutSnapshot)
+{
+	return FFileHelper::LoadFileToArray(OutSnapshot, *SnapshotPath, FILEREAD_Silent);
+}
+
+FInventoryJournal::FInventoryJournal(TUniquePtr<IInventoryJournalBackend>&& InBackend)
+	: Backend(MoveTemp(InBackend))
+{
+	check(Backend);
+}
+
+void FInventoryJournal::RecordChange(const FInventoryItemEntry& ItemEntry, EInventoryChangeKind Kind)
+{
+	using namespace UE::ItemizationCore::Persistence;
+
+	if (ItemEntry.ItemDefinition == nullptr ||
+		FItemComponentData_Traits::HasTrait(ItemEntry.ItemDefinition, UItemizationCoreSettings::Get()->TransientTag))
+	{
+		return;
+	}
+
+	FMemoryWriter Ar(PendingRecords);
+	Ar.Seek(PendingRecords.Num());
+
+	uint8 RecordType = static_cast<uint8>(Kind == EInventoryChangeKind::Removed ? EJournalRecordType::Remove : EJournalRecordType::Upsert);
+	uint32 ItemHandle = ItemEntry.ItemHandle.Get();
+	Ar << RecordType;
+	Ar.SerializeIntPacked(ItemHandle);
+
+	if (RecordType == static_cast<uint8>(EJournalRecordType::Upsert))
+	{
+		FString DefinitionId = ItemEntry.ItemDefinition->GetPrimaryAssetId().ToString();
+		uint32 SlotNumber = ItemEntry.SlotNumber + 1; // INDEX_NONE becomes 0
+		uint32 NumStats = ItemEntry.GetAllStats().Num();
+		Ar << DefinitionId;
+		Ar.SerializeIntPacked(SlotNumber);
+		Ar.SerializeIntPacked(NumStats);
+
+		for (const TPair<FGameplayTag, int32>& Stat : ItemEntry.GetAllStats())
+		{
+			FString TagString = Stat.Key.ToString();
+			int32 StatValue = Stat.Value;
+			Ar << TagString;
+			SerializeZigZag(Ar, StatValue);
+		}
+	}
+
+	++NumPendingRecords;
+	++NumRecordsSinceSnapshot;
+}
+
+bool FInventoryJournal::Flush(const AInventoryBase& Inventory)
+{
+	using namespace UE::ItemizationCore::Persistence;
+	check(IsInGameThread());
+
+	// Once the tail outgrows the threshold, replaying it costs more than loading a fresh snapshot
+	const int32 CompactionThreshold = UItemizationCoreSettings::Get()->JournalCompactionThreshold;
+	if (CompactionThreshold > 0 && NumRecordsSinceSnapshot >= CompactionThreshold)
+	{
+		return Compact(Inventory);
+	}
+
+	if (PendingRecords.IsEmpty())
+	{
+		return true;
+	}
+
+	FJournalBlockHeader Header;
+	Header.Size = PendingRecords.Num();
+	Header.Crc = FCrc::MemCrc32(PendingRecords.GetData(), PendingRecords.Num());
+
+	TArray<uint8> Block;
+	Block.Reserve(sizeof(FJournalBlockHeader) + PendingRecords.Num());
+	Block.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FJournalBlockHeader));
+	Block.Append(PendingRecords);
+
+	if (!Backend->Append(Block))
+	{
+		ITEMIZATION_WARN("Failed to append %d journal records of inventory %s.", NumPendingRecords, *GetNameSafe(&Inventory));
+		return false;
+	}
+
+	PendingRecords.Reset();
+	NumPendingRecords = 0;
+	return true;
+}
+
+bool FInventoryJournal::Compact(const AInventoryBase& Inventory)
+{
+	check(IsInGameThread());
+
+	TArray<uint8> Snapshot;
+	FInventorySerializer::Save(Inventory, Snapshot);
+
+	if (!Backend->WriteSnapshot(Snapshot))
+	{
+		ITEMIZATION_WARN("Failed to write the journal snapshot of inventory %s.", *GetNameSafe(&Inventory));
+		return false;
+	}
+
+	// The snapshot covers everything that has been recorded so far
+	PendingRecords.Reset();
+	NumPendingRecords = 0;
+	NumRecordsSinceSnapshot = 0;
+	return true;
+}
+
+bool FInventoryJournal::Recover(AInventoryBase& Inventory)
+{
+	check(IsInGameThread());
+
+	TArray<uint8> Snapshot;
+	const bool bHasSnapshot = Backend->ReadSnapshot(Snapshot);
+	if (bHasSnapshot && !FInventorySerializer::Load(Inventory, Snapshot))
+	{
+		return false;
+	}
+
+	TArray<uint8> Tail;
+	if (!Backend->ReadTail(Tail))
+	{
+		return false;
+	}
+
+	NumRecordsSinceSnapshot = ReplayTail(Inventory, Tail);
+
+	ITEMIZATION_VERBOSE("Recovered inventory %s from its journal, replayed %d records.",
+		*GetNameSafe(&Inventory), NumRecordsSinceSnapshot);
+
+	// Without a snapshot the whole history lives in the tail, write one right away so the next recovery stays cheap
+	if (!bHasSnapshot)
+	{
+		Compact(Inventory);
+	}
+
+	return true;
+}
+
+int32 FInventoryJournal::ReplayTail(AInventoryBase& Inventory, TConstArrayView<uint8> Tail) const
+{
+	using namespace UE::ItemizationCore::Persistence;
+
+	TMap<FString, UItemDefinitionBase*> ResolvedDefinitions;
+	uint32 MaxItemHandle = 0;
+	int32 NumRecords = 0;
+
+	int64 BlockOffset = 0;
+	while (BlockOffset + static_cast<int64>(sizeof(FJournalBlockHeader)) <= Tail.Num())
+	{
+		FJournalBlockHeader Header;
+		FMemory::Memcpy(&Header, Tail.GetData() + BlockOffset, sizeof(FJournalBlockHeader));
+
+		const int64 DataOffset = BlockOffset + sizeof(FJournalBlockHeader);
+		if (DataOffset + Header.Size > Tail.Num() ||
+			FCrc::MemCrc32(Tail.GetData() + DataOffset, Header.Size) != Header.Crc)
+		{
+			ITEMIZATION_WARN("Journal of inventory %s ends in a torn block, dropping the last %lld bytes.",
+				*GetNameSafe(&Inventory), Tail.Num() - BlockOffset);
+			break;
+		}
+
+		FMemoryReaderView Ar(Tail.Slice(static_cast<int32>(DataOffset), Header.Size));
+		while (!Ar.AtEnd() && !Ar.IsError())
+		{
+			uint8 RecordType = 0;
+			uint32 ItemHandle = 0;
+			Ar << RecordType;
+			Ar.SerializeIntPacked(ItemHandle);
+
+			TArray<FInventoryItemEntry>& Items = Inventory.InventoryList.Items;
+			const int32 EntryIdx = Items.IndexOfByKey(FInventoryItemHandle::FromRaw(ItemHandle));
+
+			if (RecordType == static_cast<uint8>(EJournalRecordType::Remove))
+			{
+				if (EntryIdx != INDEX_NONE)
+				{
+					FInventoryItemEntry& Entry = Items[EntryIdx];
+					Inventory.UpdateTotalCount(Entry.ItemDefinition, -Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize));
+					Inventory.UpdateNumLimitedSlots(Entry.ItemDefinition, -1);
+					Inventory.OnRemoveItem(Entry);
+					Items.RemoveAt(EntryIdx);
+					Inventory.InventoryList.MarkArrayDirty();
+				}
+				++NumRecords;
+				continue;
+			}
+
+			FString DefinitionId;
+			uint32 SlotNumber = 0;
+			uint32 NumStats = 0;
+			Ar << DefinitionId;
+			Ar.SerializeIntPacked(SlotNumber);
+			Ar.SerializeIntPacked(NumStats);
+
+			UItemDefinitionBase*& Definition = ResolvedDefinitions.FindOrAdd(DefinitionId);
+			if (Definition == nullptr)
+			{
+				Definition = ResolveDefinition(FPrimaryAssetId::FromString(DefinitionId));
+			}
+
+			// Apply to a copy, so an unresolved definition or a corrupted record never leaves a half updated entry
+			FInventoryItemEntry Entry = EntryIdx != INDEX_NONE ? Items[EntryIdx] : FInventoryItemEntry();
+			for (uint32 StatIdx = 0; StatIdx < NumStats && !Ar.IsError(); ++StatIdx)
+			{
+				FString TagString;
+				int32 StatValue = 0;
+				Ar << TagString;
+				SerializeZigZag(Ar, StatValue);
+
+				const FGameplayTag StatTag = FGameplayTag::RequestGameplayTag(FName(*TagString), false);
+				if (StatTag.IsValid())
+				{
+					Entry.SetStatValue(StatTag, StatValue);
+				}
+			}
+
+			if (Ar.IsError() || Definition == nullptr)
+			{
+				continue;
+			}
+
+			const int32 NewStackCount = Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+			Entry.SlotNumber = SlotNumber - 1;
+			Entry.LastObservedStackCount = NewStackCount;
+
+			if (EntryIdx != INDEX_NONE)
+			{
+				FInventoryItemEntry& ExistingEntry = Items[EntryIdx];
+				const int32 OldStackCount = ExistingEntry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+				Inventory.UpdateTotalCount(Definition, NewStackCount - OldStackCount);
+				ExistingEntry = MoveTemp(Entry);
+				Inventory.InventoryList.MarkItemDirty(ExistingEntry);
+
+				// Adds and removes are recorded by OnGiveItem and OnRemoveItem, updates need to dirty the snapshot themselves
+				Inventory.NotifyItemChanged(ExistingEntry, OldStackCount, NewStackCount);
+			}
+			else
+			{
+				Entry.ItemHandle = FInventoryItemHandle::FromRaw(ItemHandle);
+				Entry.ItemDefinition = Definition;
+				MaxItemHandle = FMath::Max(MaxItemHandle, ItemHandle);
+
+				FInventoryItemEntry& NewEntry = Items.Add_GetRef(MoveTemp(Entry));
+				Inventory.UpdateTotalCount(Definition, NewStackCount);
+				Inventory.UpdateNumLimitedSlots(Definition, 1);
+
+				if (Inventory.ShouldCreateNewInstanceOfItem(NewEntry))
+				{
+					Inventory.CreateNewInstanceOfItem(NewEntry);
+				}
+
+				Inventory.OnGiveItem(NewEntry);
+				Inventory.InventoryList.MarkItemDirty(NewEntry);
+			}
+
+			++NumRecords;
+		}
+
+		BlockOffset = DataOffset + Header.Size;
+	}
+
+	FInventoryItemHandle::ReserveUIDs(MaxItemHandle);
+	return NumRecords;
+}
\ No newline at end of file
@@ -0,0 +1,274 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Persistence/InventoryPersistenceSubsystem.h"
+
+#include "ItemizationCoreSettings.h"
+#include "ItemizationLogChannels.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Inventory/InventoryBase.h"
+#include "Misc/Paths.h"
+#include "Persistence/InventorySaveData.h"
+#include "Persistence/InventoryStorageProvider.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryPersistenceSubsystem)
+
+UInventoryPersistenceSubsystem* UInventoryPersistenceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UInventoryPersistenceSubsystem>() : nullptr;
+}
+
+void UInventoryPersistenceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	StorageProvider = MakeShared<FInventoryLocalFileStorageProvider>(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Inventories")));
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::Tick));
+}
+
+void UInventoryPersistenceSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Don't lose anything that changed within the last save window
+	FlushDirtyInventories();
+	LastEncode.Wait();
+	StorageProvider->Flush();
+
+	for (TPair<TWeakObjectPtr<AInventoryBase>, FRegisteredInventory>& Pair : RegisteredInventories)
+	{
+		if (AInventoryBase* Inventory = Pair.Key.Get())
+		{
+			Inventory->OnChangeSetDelegate.Remove(Pair.Value.ChangeSetHandle);
+		}
+	}
+	RegisteredInventories.Reset();
+
+	Super::Deinitialize();
+}
+
+void UInventoryPersistenceSubsystem::SetStorageProvider(TSharedRef<IInventoryStorageProvider> InStorageProvider)
+{
+	LastEncode.Wait();
+	if (StorageProvider.IsValid())
+	{
+		StorageProvider->Flush();
+	}
+	StorageProvider = MoveTemp(InStorageProvider);
+}
+
+void UInventoryPersistenceSubsystem::RegisterInventory(AInventoryBase* Inventory, const FString& Key)
+{
+	if (!IsValid(Inventory) || !Inventory->HasAuthority() || Key.IsEmpty())
+	{
+		return;
+	}
+
+	FRegisteredInventory& Registered = RegisteredInventories.FindOrAdd(Inventory);
+	Registered.Key = Key;
+
+	if (!Registered.ChangeSetHandle.IsValid())
+	{
+		Registered.ChangeSetHandle = Inventory->OnChangeSetDelegate.AddUObject(this, &ThisClass::HandleChangeSet);
+	}
+}
+
+void UInventoryPersistenceSubsystem::UnregisterInventory(AInventoryBase* Inventory)
+{
+	const TWeakObjectPtr<AInventoryBase> WeakInventory(Inventory);
+	const FRegisteredInventory* Registered = RegisteredInventories.Find(WeakInventory);
+	if (Registered == nullptr)
+	{
+		return;
+	}
+
+	if (Registered->bDirty)
+	{
+		--NumDirtyInventories;
+
+		// Still write the last changes, the key isn't known anymore afterwards
+		WriteInventories(MakeArrayView(&WeakInventory, 1));
+	}
+
+	if (IsValid(Inventory))
+	{
+		Inventory->OnChangeSetDelegate.Remove(Registered->ChangeSetHandle);
+	}
+
+	RegisteredInventories.Remove(WeakInventory);
+}
+
+void UInventoryPersistenceSubsystem::MarkDirty(AInventoryBase* Inventory)
+{
+	FRegisteredInventory* Registered = RegisteredInventories.Find(Inventory);
+	if (Registered == nullptr)
+	{
+		return;
+	}
+
+	++NumDirtyMarks;
+
+	if (!Registered->bDirty)
+	{
+		Registered->bDirty = true;
+		if (NumDirtyInventories++ == 0)
+		{
+			FirstDirtyTime = FPlatformTime::Seconds();
+		}
+	}
+}
+
+void UInventoryPersistenceSubsystem::FlushDirtyInventories()
+{
+	if (NumDirtyInventories == 0)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<AInventoryBase>> DirtyInventories;
+	DirtyInventories.Reserve(NumDirtyInventories);
+
+	for (auto It = RegisteredInventories.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (It.Value().bDirty)
+		{
+			It.Value().bDirty = false;
+			DirtyInventories.Add(It.Key());
+		}
+	}
+
+	NumDirtyInventories = 0;
+	WriteInventories(DirtyInventories);
+}
+
+void UInventoryPersistenceSubsystem::LoadInventory(AInventoryBase* Inventory, const FString& Key, FInventoryStorageLoadCompleted&& OnCompleted)
+{
+	TArray<FString> Keys;
+	Keys.Add(Key);
+
+	// Writes only reach the provider once their encoding task ran, so the read has to queue up behind them.
+	// Otherwise a load right after a save of the same key would read the previous record.
+	LastEncode = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[StorageProvider = StorageProvider, Keys = MoveTemp(Keys), WeakInventory = TWeakObjectPtr<AInventoryBase>(Inventory), OnCompleted = MoveTemp(OnCompleted)]() mutable
+		{
+			StorageProvider->ReadBatch(MoveTemp(Keys),
+				[WeakInventory, OnCompleted = MoveTemp(OnCompleted)](TArray<FInventoryStorageRecord>&& Records)
+				{
+					AInventoryBase* LoadedInventory = WeakInventory.Get();
+					const bool bSuccess = LoadedInventory && Records.Num() == 1 && FInventorySerializer::Load(*LoadedInventory, Records[0].Bytes);
+
+					if (OnCompleted)
+					{
+						OnCompleted(bSuccess);
+					}
+				});
+		},
+		UE::Tasks::Prerequisites(LastEncode));
+}
+
+bool UInventoryPersistenceSubsystem::Tick(float DeltaTime)
+{
+	if (NumDirtyInventories > 0 &&
+		FPlatformTime::Seconds() - FirstDirtyTime >= UItemizationCoreSettings::Get()->SaveCoalescingWindow)
+	{
+		FlushDirtyInventories();
+	}
+
+	return true;
+}
+
+void UInventoryPersistenceSubsystem::HandleChangeSet(const FInventoryChangeSet& ChangeSet)
+{
+	MarkDirty(ChangeSet.Inventory.Get());
+}
+
+void UInventoryPersistenceSubsystem::WriteInventories(TArrayView<const TWeakObjectPtr<AInventoryBase>> Inventories)
+{
+	struct FCapturedInventory
+	{
+		FString Key;
+		FInventorySaveData Data;
+	};
+
+	const int32 MaxInventoriesPerWrite = FMath::Max(1, UItemizationCoreSettings::Get()->MaxInventoriesPerWrite);
+
+	for (int32 BatchStart = 0; BatchStart < Inventories.Num(); BatchStart += MaxInventoriesPerWrite)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + MaxInventoriesPerWrite, Inventories.Num());
+
+		// Capturing only copies plain data, everything expensive happens on the task
+		TSharedRef<TArray<FCapturedInventory>> Batch = MakeShared<TArray<FCapturedInventory>>();
+		Batch->Reserve(BatchEnd - BatchStart);
+
+		for (int32 Idx = BatchStart; Idx < BatchEnd; ++Idx)
+		{
+			const AInventoryBase* Inventory = Inventories[Idx].Get();
+			const FRegisteredInventory* Registered = RegisteredInventories.Find(Inventories[Idx]);
+			if (Inventory == nullptr || Registered == nullptr)
+			{
+				continue;
+			}
+
+			FCapturedInventory& Captured = Batch->AddDefaulted_GetRef();
+			Captured.Key = Registered->Key;
+			FInventorySerializer::Capture(*Inventory, Captured.Data);
+		}
+
+		if (Batch->IsEmpty())
+		{
+			continue;
+		}
+
+		NumWrittenInventories += Batch->Num();
+
+		LastEncode = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Batch, StorageProvider = StorageProvider, WeakThis = TWeakObjectPtr<ThisClass>(this)]()
+			{
+				TArray<FInventoryStorageRecord> Records;
+				Records.Reserve(Batch->Num());
+
+				TArray<uint8> Encoded;
+				for (const FCapturedInventory& Captured : *Batch)
+				{
+					FInventorySerializer::Encode(Captured.Data, Encoded);
+
+					FInventoryStorageRecord& Record = Records.AddDefaulted_GetRef();
+					Record.Key = Captured.Key;
+					FInventorySerializer::Compress(Encoded, Record.Bytes);
+				}
+
+				StorageProvider->WriteBatch(MoveTemp(Records), [WeakThis](TArray<FString>&& FailedKeys)
+				{
+					UInventoryPersistenceSubsystem* This = WeakThis.Get();
+					if (This && !FailedKeys.IsEmpty())
+					{
+						This->HandleWriteFailed(MoveTemp(FailedKeys));
+					}
+				});
+			},
+			UE::Tasks::Prerequisites(LastEncode));
+	}
+}
+
+void UInventoryPersistenceSubsystem::HandleWriteFailed(TArray<FString>&& FailedKeys)
+{
+	ITEMIZATION_WARN("Failed to write %d inventories to the storage, retrying with the next batch.", FailedKeys.Num());
+
+	for (const TPair<TWeakObjectPtr<AInventoryBase>, FRegisteredInventory>& Pair : RegisteredInventories)
+	{
+		if (FailedKeys.Contains(Pair.Value.Key))
+		{
+			MarkDirty(Pair.Key.Get());
+		}
+	}
+}
@@ -0,0 +1,38 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemizationSerializationUtils.h"
+#include "Engine/AssetManager.h"
+#include "Items/InventoryItemInstance.h"
+#include "Items/ItemDefinitionBase.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace UE::ItemizationCore::Persistence
+{
+	using UE::ItemizationCore::SerializeZigZag;
+
+	/**
+	 * Serializes the SaveGame properties of an item instance.
+	 * With bFullState, every non-transient property is serialized instead, e.g. to hand the instance over to another server.
+	 */
+	inline void SerializeInstance(UInventoryItemInstance* Instance, FArchive& InnerAr, bool bFullState = false)
+	{
+		FObjectAndNameAsStringProxyArchive Ar(InnerAr, true);
+		Ar.ArIsSaveGame = !bFullState;
+		Instance->Serialize(Ar);
+	}
+
+	/** Resolves a saved definition id. Should only be called once per definition and save. */
+	inline UItemDefinitionBase* ResolveDefinition(const FPrimaryAssetId& DefinitionId)
+	{
+		UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+		if (!DefinitionId.IsValid() || AssetManager == nullptr)
+		{
+			return nullptr;
+		}
+
+		return Cast<UItemDefinitionBase>(AssetManager->GetPrimaryAssetPath(DefinitionId).TryLoad());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,527 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Persistence/InventorySaveData.h"
+
+#include "ItemizationCoreSettings.h"
+#include "ItemizationLogChannels.h"
+#include "ItemizationStats.h"
+#include "InventoryPersistenceUtils.h"
+#include "Inventory/InventoryBase.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Items/Data/ItemComponentData_Traits.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+void FInventorySaveData::Reset()
+{
+	Definitions.Reset();
+	StatTags.Reset();
+	Entries.Reset();
+	MaxNumSlots = INDEX_NONE;
+}
+
+void FInventorySerializer::Capture(const AInventoryBase& Inventory, FInventorySaveData& OutData, bool bIncludeTransient, bool bFullInstanceState)
+{
+	using namespace UE::ItemizationCore::Persistence;
+	check(IsInGameThread());
+
+	OutData.Reset();
+	OutData.MaxNumSlots = Inventory.GetMaxNumSlots();
+	OutData.Entries.Reserve(Inventory.InventoryList.Num());
+
+	const FGameplayTag& TransientTag = UItemizationCoreSettings::Get()->TransientTag;
+
+	TMap<const UItemDefinitionBase*, int32, TInlineSetAllocator<16>> DefinitionIndices;
+	TMap<FGameplayTag, int32, TInlineSetAllocator<8>> StatIndices;
+
+	for (const FInventoryItemEntry& Entry : Inventory.InventoryList)
+	{
+		if (Entry.ItemDefinition == nullptr ||
+			(!bIncludeTransient && FItemComponentData_Traits::HasTrait(Entry.ItemDefinition, TransientTag)))
+		{
+			continue;
+		}
+
+		FInventorySaveEntry& SaveEntry = OutData.Entries.AddDefaulted_GetRef();
+		SaveEntry.ItemHandle = Entry.ItemHandle.Get();
+		SaveEntry.SlotNumber = Entry.SlotNumber;
+
+		int32* DefinitionIndex = DefinitionIndices.Find(Entry.ItemDefinition);
+		if (DefinitionIndex == nullptr)
+		{
+			DefinitionIndex = &DefinitionIndices.Add(Entry.ItemDefinition, OutData.Definitions.Add(Entry.ItemDefinition->GetPrimaryAssetId()));
+		}
+		SaveEntry.DefinitionIndex = *DefinitionIndex;
+
+		// Values are written in slot order, so build the mask first
+		for (const TPair<FGameplayTag, int32>& Stat : Entry.GetAllStats())
+		{
+			int32 StatIndex = INDEX_NONE;
+			if (const int32* FoundIndex = StatIndices.Find(Stat.Key))
+			{
+				StatIndex = *FoundIndex;
+			}
+			else if (OutData.StatTags.Num() < FInventorySaveData::MaxNumStatSlots)
+			{
+				StatIndex = StatIndices.Add(Stat.Key, OutData.StatTags.Add(Stat.Key));
+			}
+			else
+			{
+				ensureMsgf(false, TEXT("Inventory %s uses more than %d distinct stats, dropping %s from the save."),
+					*GetNameSafe(&Inventory), FInventorySaveData::MaxNumStatSlots, *Stat.Key.ToString());
+				continue;
+			}
+
+			SaveEntry.StatMask |= 1ull << StatIndex;
+		}
+
+		for (uint64 Mask = SaveEntry.StatMask; Mask != 0; Mask &= Mask - 1)
+		{
+			SaveEntry.StatValues.Add(Entry.GetStatValue(OutData.StatTags[FMath::CountTrailingZeros64(Mask)]));
+		}
+
+		if (UInventoryItemInstance* Instance = Entry.GetItemInstance())
+		{
+			FMemoryWriter Writer(SaveEntry.InstancePayload);
+			SerializeInstance(Instance, Writer, bFullInstanceState);
+		}
+	}
+}
+
+void FInventorySerializer::Encode(const FInventorySaveData& Data, TArray<uint8>& OutBytes)
+{
+	using namespace UE::ItemizationCore::Persistence;
+
+	OutBytes.Reset();
+	FMemoryWriter Ar(OutBytes);
+
+	uint32 MagicValue = Magic;
+	uint16 Version = static_cast<uint16>(EInventorySaveVersion::Latest);
+	int32 MaxNumSlots = Data.MaxNumSlots;
+	Ar << MagicValue;
+	Ar << Version;
+	SerializeZigZag(Ar, MaxNumSlots);
+
+	uint32 NumDefinitions = Data.Definitions.Num();
+	Ar.SerializeIntPacked(NumDefinitions);
+	for (const FPrimaryAssetId& DefinitionId : Data.Definitions)
+	{
+		FString IdString = DefinitionId.ToString();
+		Ar << IdString;
+	}
+
+	uint32 NumStatTags = Data.StatTags.Num();
+	Ar.SerializeIntPacked(NumStatTags);
+	for (const FGameplayTag& StatTag : Data.StatTags)
+	{
+		FString TagString = StatTag.ToString();
+		Ar << TagString;
+	}
+
+	uint32 NumEntries = Data.Entries.Num();
+	Ar.SerializeIntPacked(NumEntries);
+	for (const FInventorySaveEntry& Entry : Data.Entries)
+	{
+		uint32 ItemHandle = Entry.ItemHandle;
+		uint32 DefinitionIndex = Entry.DefinitionIndex;
+		uint32 SlotNumber = Entry.SlotNumber + 1; // INDEX_NONE becomes 0
+		uint64 StatMask = Entry.StatMask;
+		Ar.SerializeIntPacked(ItemHandle);
+		Ar.SerializeIntPacked(DefinitionIndex);
+		Ar.SerializeIntPacked(SlotNumber);
+		Ar.SerializeIntPacked64(StatMask);
+
+		for (int32 StatValue : Entry.StatValues)
+		{
+			SerializeZigZag(Ar, StatValue);
+		}
+
+		uint32 PayloadSize = Entry.InstancePayload.Num();
+		Ar.SerializeIntPacked(PayloadSize);
+		if (PayloadSize > 0)
+		{
+			Ar.Serialize(const_cast<uint8*>(Entry.InstancePayload.GetData()), PayloadSize);
+		}
+	}
+}
+
+void FInventorySerializer::Save(const AInventoryBase& Inventory, TArray<uint8>& OutBytes)
+{
+	FInventorySaveData Data;
+	Capture(Inventory, Data);
+	Encode(Data, OutBytes);
+}
+
+UE::Tasks::FTask FInventorySerializer::SaveAsync(
+	const AInventoryBase& Inventory,
+	const FString& FilePath,
+	FInventorySaveCompleted&& OnCompleted,
+	const UE::Tasks::FTask& Prerequisite)
+{
+	check(IsInGameThread());
+
+	// Capturing only copies plain data, everything expensive happens on the task
+	TSharedRef<FInventorySaveData> Data = MakeShared<FInventorySaveData>();
+	Capture(Inventory, *Data);
+
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Data, FilePath, OnCompleted = MoveTemp(OnCompleted)]() mutable
+		{
+			TArray<uint8> Bytes;
+			Encode(*Data, Bytes);
+
+			TArray<uint8> Compressed;
+			Compress(Bytes, Compressed);
+
+			// Write to a temporary file first, so a crash while writing never corrupts the previous save
+			const FString TempPath = FilePath + TEXT(".tmp");
+			const bool bSuccess =
+				FFileHelper::SaveArrayToFile(Compressed, *TempPath) &&
+				IFileManager::Get().Move(*FilePath, *TempPath, true, true);
+
+			if (!bSuccess)
+			{
+				ITEMIZATION_WARN("Failed to write inventory save %s.", *FilePath);
+			}
+
+			if (OnCompleted)
+			{
+				AsyncTask(ENamedThreads::GameThread, [OnCompleted = MoveTemp(OnCompleted), bSuccess]()
+				{
+					OnCompleted(bSuccess);
+				});
+			}
+		},
+		UE::Tasks::Prerequisites(Prerequisite));
+}
+
+void FInventorySerializer::Compress(TConstArrayView<uint8> Bytes, TArray<uint8>& OutCompressed)
+{
+	const int32 HeaderSize = sizeof(uint32) * 2;
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Bytes.Num());
+
+	OutCompressed.SetNumUninitialized(HeaderSize + CompressedSize);
+
+	const uint32 Header[2] = { CompressedMagic, static_cast<uint32>(Bytes.Num()) };
+	FMemory::Memcpy(OutCompressed.GetData(), Header, HeaderSize);
+
+	if (!FCompression::CompressMemory(NAME_Oodle, OutCompressed.GetData() + HeaderSize, CompressedSize, Bytes.GetData(), Bytes.Num()))
+	{
+		// Fall back to storing the save as it is, Load accepts both
+		OutCompressed.Reset();
+		OutCompressed.Append(Bytes.GetData(), Bytes.Num());
+		return;
+	}
+
+	OutCompressed.SetNum(HeaderSize + CompressedSize, EAllowShrinking::No);
+}
+
+bool FInventorySerializer::Decompress(TConstArrayView<uint8> Compressed, TArray<uint8>& OutBytes)
+{
+	const int32 HeaderSize = sizeof(uint32) * 2;
+	if (Compressed.Num() < HeaderSize)
+	{
+		return false;
+	}
+
+	uint32 Header[2];
+	FMemory::Memcpy(Header, Compressed.GetData(), HeaderSize);
+
+	// Oodle doesn't expand data by more than a tiny bit per block, so this bounds the allocation for corrupted saves
+	constexpr uint32 MaxRatio = 1024;
+	if (Header[0] != CompressedMagic || Header[1] / MaxRatio > static_cast<uint32>(Compressed.Num()))
+	{
+		return false;
+	}
+
+	OutBytes.SetNumUninitialized(Header[1]);
+	return FCompression::UncompressMemory(NAME_Oodle, OutBytes.GetData(), OutBytes.Num(), Compressed.GetData() + HeaderSize, Compressed.Num() - HeaderSize);
+}
+
+bool FInventorySerializer::Load(AInventoryBase& Inventory, TConstArrayView<uint8> Bytes, FInventoryLoadContext* Context)
+{
+	using namespace UE::ItemizationCore::Persistence;
+	check(IsInGameThread());
+
+	uint32 LeadingMagic = 0;
+	if (Bytes.Num() >= sizeof(uint32))
+	{
+		FMemory::Memcpy(&LeadingMagic, Bytes.GetData(), sizeof(uint32));
+	}
+
+	if (LeadingMagic == CompressedMagic)
+	{
+		TArray<uint8> Decompressed;
+		if (!Decompress(Bytes, Decompressed))
+		{
+			ITEMIZATION_WARN("Failed to load inventory %s: the compressed save is corrupted.", *GetNameSafe(&Inventory));
+			return false;
+		}
+
+		return Load(Inventory, Decompressed, Context);
+	}
+
+	if (!ensureMsgf(Inventory.InventoryList.IsEmpty(),
+		TEXT("Can only load into an empty inventory, but %s already holds items."), *GetNameSafe(&Inventory)))
+	{
+		return false;
+	}
+
+	FMemoryReaderView Ar(Bytes);
+
+	uint32 MagicValue = 0;
+	uint16 Version = 0;
+	int32 MaxNumSlots = INDEX_NONE;
+	Ar << MagicValue;
+	Ar << Version;
+	SerializeZigZag(Ar, MaxNumSlots);
+
+	if (Ar.IsError() || MagicValue != Magic || Version == 0 || Version > static_cast<uint16>(EInventorySaveVersion::Latest))
+	{
+		ITEMIZATION_WARN("Failed to load inventory %s: unknown save format (magic 0x%08X, version %d).",
+			*GetNameSafe(&Inventory), MagicValue, Version);
+		return false;
+	}
+
+	// Resolve the tables once, so entries only need index lookups
+	uint32 NumDefinitions = 0;
+	Ar.SerializeIntPacked(NumDefinitions);
+	if (Ar.IsError() || NumDefinitions > static_cast<uint32>(Bytes.Num()))
+	{
+		return false;
+	}
+
+	TArray<UItemDefinitionBase*, TInlineAllocator<16>> Definitions;
+	Definitions.Reserve(NumDefinitions);
+	for (uint32 Idx = 0; Idx < NumDefinitions && !Ar.IsError(); ++Idx)
+	{
+		FString IdString;
+		Ar << IdString;
+
+		const FPrimaryAssetId DefinitionId = FPrimaryAssetId::FromString(IdString);
+
+		UItemDefinitionBase* Definition = nullptr;
+		if (Context == nullptr)
+		{
+			Definition = ResolveDefinition(DefinitionId);
+		}
+		else if (const TWeakObjectPtr<UItemDefinitionBase>* Resolved = Context->ResolvedDefinitions.Find(DefinitionId))
+		{
+			Definition = Resolved->Get();
+		}
+		else
+		{
+			Definition = ResolveDefinition(DefinitionId);
+			Context->ResolvedDefinitions.Add(DefinitionId, Definition);
+		}
+
+		if (Definition == nullptr)
+		{
+			ITEMIZATION_WARN("Dropping saved items of %s from inventory %s, the definition couldn't be resolved.",
+				*IdString, *GetNameSafe(&Inventory));
+		}
+		Definitions.Add(Definition);
+	}
+
+	uint32 NumStatTags = 0;
+	Ar.SerializeIntPacked(NumStatTags);
+	if (Ar.IsError() || NumStatTags > FInventorySaveData::MaxNumStatSlots)
+	{
+		return false;
+	}
+
+	TArray<FGameplayTag, TInlineAllocator<FInventorySaveData::MaxNumStatSlots>> StatTags;
+	for (uint32 Idx = 0; Idx < NumStatTags && !Ar.IsError(); ++Idx)
+	{
+		FString TagString;
+		Ar << TagString;
+		StatTags.Add(FGameplayTag::RequestGameplayTag(FName(*TagString), false));
+	}
+
+	// Every entry takes at least one byte, which bounds the allocation for corrupted saves
+	uint32 NumEntries = 0;
+	Ar.SerializeIntPacked(NumEntries);
+	if (Ar.IsError() || NumEntries > static_cast<uint32>(Bytes.Num()))
+	{
+		return false;
+	}
+
+	TArray<FInventoryItemEntry>& Items = Inventory.InventoryList.Items;
+	Items.SetNum(NumEntries);
+
+	TArray<TPair<int32, TConstArrayView<uint8>>, TInlineAllocator<16>> InstancePayloads;
+	uint32 MaxItemHandle = 0;
+	int32 NumRestored = 0;
+
+	for (uint32 Idx = 0; Idx < NumEntries && !Ar.IsError(); ++Idx)
+	{
+		uint32 ItemHandle = 0;
+		uint32 DefinitionIndex = 0;
+		uint32 SlotNumber = 0;
+		uint64 StatMask = 0;
+		Ar.SerializeIntPacked(ItemHandle);
+		Ar.SerializeIntPacked(DefinitionIndex);
+		Ar.SerializeIntPacked(SlotNumber);
+		Ar.SerializeIntPacked64(StatMask);
+
+		UItemDefinitionBase* Definition = Definitions.IsValidIndex(DefinitionIndex) ? Definitions[DefinitionIndex] : nullptr;
+		const bool bRestore = Definition != nullptr && ItemHandle != FInventoryItemHandle::INVALID_HANDLE;
+
+		FInventoryItemEntry& Entry = Items[NumRestored];
+		for (uint64 Mask = StatMask; Mask != 0; Mask &= Mask - 1)
+		{
+			int32 StatValue = 0;
+			SerializeZigZag(Ar, StatValue);
+
+			const int32 StatIndex = FMath::CountTrailingZeros64(Mask);
+			if (bRestore && StatTags.IsValidIndex(StatIndex) && StatTags[StatIndex].IsValid())
+			{
+				Entry.SetStatValue(StatTags[StatIndex], StatValue);
+			}
+		}
+
+		uint32 PayloadSize = 0;
+		Ar.SerializeIntPacked(PayloadSize);
+
+		const int64 PayloadOffset = Ar.Tell();
+		if (PayloadSize > Bytes.Num() - PayloadOffset)
+		{
+			Ar.SetError();
+			break;
+		}
+		Ar.Seek(PayloadOffset + PayloadSize);
+
+		if (!bRestore)
+		{
+			continue;
+		}
+
+		Entry.ItemHandle = FInventoryItemHandle::FromRaw(ItemHandle);
+		Entry.ItemDefinition = Definition;
+		Entry.SlotNumber = SlotNumber - 1;
+		Entry.LastObservedStackCount = Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+		MaxItemHandle = FMath::Max(MaxItemHandle, ItemHandle);
+
+		if (PayloadSize > 0)
+		{
+			InstancePayloads.Emplace(NumRestored, Bytes.Slice(PayloadOffset, PayloadSize));
+		}
+
+		++NumRestored;
+	}
+
+	if (Ar.IsError())
+	{
+		ITEMIZATION_WARN("Failed to load inventory %s: the save is corrupted.", *GetNameSafe(&Inventory));
+		Items.Reset();
+		return false;
+	}
+
+	Items.SetNum(NumRestored);
+	FInventoryItemHandle::ReserveUIDs(MaxItemHandle);
+	ITEMIZATION_INC_STAT_BY(NumEntries, NumRestored);
+	Inventory.SetMaxNumSlots(MaxNumSlots);
+
+	// The list is complete, now create the instances and totals in one go
+	TMap<const UItemDefinitionBase*, int32, TInlineSetAllocator<16>> Totals;
+	int32 PayloadIdx = 0;
+
+	for (int32 Idx = 0; Idx < Items.Num(); ++Idx)
+	{
+		FInventoryItemEntry& Entry = Items[Idx];
+		Totals.FindOrAdd(Entry.ItemDefinition) += Entry.LastObservedStackCount;
+		Inventory.UpdateNumLimitedSlots(Entry.ItemDefinition, 1);
+
+		const bool bHasPayload = InstancePayloads.IsValidIndex(PayloadIdx) && InstancePayloads[PayloadIdx].Key == Idx;
+		if (Inventory.ShouldCreateNewInstanceOfItem(Entry) && Context && Context->bDeferInstances)
+		{
+			FInventoryDeferredInstance& Deferred = Context->DeferredInstances.AddDefaulted_GetRef();
+			Deferred.Inventory = &Inventory;
+			Deferred.ItemHandle = Entry.ItemHandle;
+			if (bHasPayload)
+			{
+				Deferred.Payload.Append(InstancePayloads[PayloadIdx].Value.GetData(), InstancePayloads[PayloadIdx].Value.Num());
+			}
+		}
+		else if (Inventory.ShouldCreateNewInstanceOfItem(Entry))
+		{
+			UInventoryItemInstance* Instance = Inventory.CreateNewInstanceOfItem(Entry);
+			if (bHasPayload)
+			{
+				FMemoryReaderView PayloadReader(InstancePayloads[PayloadIdx].Value);
+				SerializeInstance(Instance, PayloadReader, Context && Context->bFullInstanceState);
+			}
+
+			Instance->OnAddedToInventory(Entry, Inventory.InventoryHandle);
+		}
+
+		PayloadIdx += bHasPayload ? 1 : 0;
+		Inventory.InventoryList.MarkItemDirty(Entry);
+	}
+
+	for (const TPair<const UItemDefinitionBase*, int32>& Total : Totals)
+	{
+		Inventory.UpdateTotalCount(Total.Key, Total.Value);
+	}
+
+	if (Inventory.bWantsSnapshots.load(std::memory_order_relaxed))
+	{
+		Inventory.bSnapshotDirty = true;
+		Inventory.RequestFlush();
+	}
+
+	ITEMIZATION_VERBOSE("Loaded %d items into inventory %s (save version %d).",
+		NumRestored, *GetNameSafe(&Inventory), Version);
+
+	return true;
+}
+
+int32 FInventorySerializer::CreateDeferredInstances(FInventoryLoadContext& Context, double MaxSeconds)
+{
+	using namespace UE::ItemizationCore::Persistence;
+	check(IsInGameThread());
+
+	const double EndTime = FPlatformTime::Seconds() + MaxSeconds;
+	int32 NumCreated = 0;
+
+	while (Context.HasDeferredInstances())
+	{
+		if (MaxSeconds > 0.0 && NumCreated > 0 && FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+
+		FInventoryDeferredInstance& Deferred = Context.DeferredInstances[Context.NextDeferredInstance++];
+		AInventoryBase* Inventory = Deferred.Inventory.Get();
+		FInventoryItemEntry* Entry = Inventory ? Inventory->InventoryList.Items.FindByKey(Deferred.ItemHandle) : nullptr;
+
+		// The entry might have been removed or got an instance in the meantime
+		if (Entry == nullptr || Entry->GetItemInstance() != nullptr)
+		{
+			continue;
+		}
+
+		UInventoryItemInstance* Instance = Inventory->CreateNewInstanceOfItem(*Entry);
+		if (!Deferred.Payload.IsEmpty())
+		{
+			FMemoryReader PayloadReader(Deferred.Payload);
+			SerializeInstance(Instance, PayloadReader, Context.bFullInstanceState);
+		}
+
+		Instance->OnAddedToInventory(*Entry, Inventory->InventoryHandle);
+		Inventory->InventoryList.MarkItemDirty(*Entry);
+		++NumCreated;
+	}
+
+	if (!Context.HasDeferredInstances())
+	{
+		Context.DeferredInstances.Reset();
+		Context.NextDeferredInstance = 0;
+	}
+
+	return NumCreated;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Persistence/InventoryStorageProvider.h"
+
+#include "ItemizationLogChannels.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FInventoryLocalFileStorageProvider::FInventoryLocalFileStorageProvider(const FString& InDirectory)
+	: Directory(InDirectory)
+{
+}
+
+FInventoryLocalFileStorageProvider::~FInventoryLocalFileStorageProvider()
+{
+	Flush();
+}
+
+FString FInventoryLocalFileStorageProvider::GetFilePath(const FString& Directory, const FString& Key)
+{
+	return FPaths::Combine(Directory, FPaths::MakeValidFileName(Key) + TEXT(".inv"));
+}
+
+void FInventoryLocalFileStorageProvider::WriteBatch(TArray<FInventoryStorageRecord>&& Records, FInventoryStorageWriteCompleted&& OnCompleted)
+{
+	FScopeLock Lock(&BatchLock);
+
+	LastBatch = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Directory = Directory, Records = MoveTemp(Records), OnCompleted = MoveTemp(OnCompleted)]() mutable
+		{
+			TArray<FString> FailedKeys;
+			for (const FInventoryStorageRecord& Record : Records)
+			{
+				// Write to a temporary file first, so a crash while writing never corrupts the previous save
+				const FString FilePath = GetFilePath(Directory, Record.Key);
+				const FString TempPath = FilePath + TEXT(".tmp");
+				if (!FFileHelper::SaveArrayToFile(Record.Bytes, *TempPath) ||
+					!IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+				{
+					FailedKeys.Add(Record.Key);
+				}
+			}
+
+			if (OnCompleted)
+			{
+				AsyncTask(ENamedThreads::GameThread, [OnCompleted = MoveTemp(OnCompleted), FailedKeys = MoveTemp(FailedKeys)]() mutable
+				{
+					OnCompleted(MoveTemp(FailedKeys));
+				});
+			}
+		},
+		UE::Tasks::Prerequisites(LastBatch));
+}
+
+void FInventoryLocalFileStorageProvider::ReadBatch(TArray<FString>&& Keys, FInventoryStorageReadCompleted&& OnCompleted)
+{
+	FScopeLock Lock(&BatchLock);
+
+	LastBatch = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Directory = Directory, Keys = MoveTemp(Keys), OnCompleted = MoveTemp(OnCompleted)]() mutable
+		{
+			TArray<FInventoryStorageRecord> Records;
+			Records.Reserve(Keys.Num());
+
+			for (FString& Key : Keys)
+			{
+				FInventoryStorageRecord Record;
+				if (FFileHelper::LoadFileToArray(Record.Bytes, *GetFilePath(Directory, Key), FILEREAD_Silent))
+				{
+					Record.Key = MoveTemp(Key);
+					Records.Add(MoveTemp(Record));
+				}
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [OnCompleted = MoveTemp(OnCompleted), Records = MoveTemp(Records)]() mutable
+			{
+				OnCompleted(MoveTemp(Records));
+			});
+		},
+		UE::Tasks::Prerequisites(LastBatch));
+}
+
+void FInventoryLocalFileStorageProvider::Flush()
+{
+	UE::Tasks::FTask Batch;
+	{
+		FScopeLock Lock(&BatchLock);
+		Batch = LastBatch;
+	}
+
+	Batch.Wait();
+}
@@ -0,0 +1,108 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/Event.h"
+#include "Misc/AutomationTest.h"
+
+#include "Inventory/InventoryBase.h"
+#include "Persistence/InventoryPersistenceSubsystem.h"
+#include "Persistence/InventoryStorageProvider.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::ItemizationCore::Tests
+{
+	/** Keeps all records in memory. Writes apply as soon as they reach the provider, reads capture what the key holds at that point. */
+	class FInMemoryStorageProvider : public IInventoryStorageProvider
+	{
+	public:
+		FInMemoryStorageProvider()
+			: ReadEvent(FPlatformProcess::GetSynchEventFromPool(true))
+		{
+		}
+
+		virtual ~FInMemoryStorageProvider() override
+		{
+			FPlatformProcess::ReturnSynchEventToPool(ReadEvent);
+		}
+
+		//~ Begin IInventoryStorageProvider Interface
+		virtual void WriteBatch(TArray<FInventoryStorageRecord>&& Records, FInventoryStorageWriteCompleted&& OnCompleted) override
+		{
+			FScopeLock Lock(&RecordsLock);
+			for (FInventoryStorageRecord& Record : Records)
+			{
+				StoredRecords.Add(Record.Key, MoveTemp(Record.Bytes));
+			}
+		}
+
+		virtual void ReadBatch(TArray<FString>&& Keys, FInventoryStorageReadCompleted&& OnCompleted) override
+		{
+			{
+				FScopeLock Lock(&RecordsLock);
+				ReadBytes = Keys.IsEmpty() ? TArray<uint8>() : StoredRecords.FindRef(Keys[0]);
+			}
+			ReadEvent->Trigger();
+		}
+
+		virtual void Flush() override
+		{
+		}
+		//~ End IInventoryStorageProvider Interface
+
+		FCriticalSection RecordsLock;
+		TMap<FString, TArray<uint8>> StoredRecords;
+		TArray<uint8> ReadBytes;
+		FEvent* ReadEvent;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryPersistenceSaveThenLoadTest, "ItemizationCore.Persistence.SaveThenLoad",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryPersistenceSaveThenLoadTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::ItemizationCore::Tests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AInventoryBase* Inventory = World->SpawnActor<AInventoryBase>();
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	UInventoryPersistenceSubsystem* Subsystem = NewObject<UInventoryPersistenceSubsystem>(GameInstance);
+
+	// The key holds an outdated record that the save has to replace before the load reads it
+	const FString Key = TEXT("SaveThenLoad");
+	const TArray<uint8> StaleBytes = { 0xDE, 0xAD };
+
+	TSharedRef<FInMemoryStorageProvider> Provider = MakeShared<FInMemoryStorageProvider>();
+	Provider->StoredRecords.Add(Key, StaleBytes);
+	Subsystem->SetStorageProvider(Provider);
+
+	if (TestNotNull(TEXT("Inventory"), Inventory))
+	{
+		Subsystem->RegisterInventory(Inventory, Key);
+		Subsystem->MarkDirty(Inventory);
+		Subsystem->FlushDirtyInventories();
+		Subsystem->LoadInventory(Inventory, Key, nullptr);
+
+		if (TestTrue(TEXT("The load reached the storage provider"), Provider->ReadEvent->Wait(FTimespan::FromSeconds(5.0))))
+		{
+			FScopeLock Lock(&Provider->RecordsLock);
+			TestNotEqual(TEXT("The load read the record written by the save"), Provider->ReadBytes, StaleBytes);
+			TestEqual(TEXT("The load read the latest record"), Provider->ReadBytes, Provider->StoredRecords.FindRef(Key));
+		}
+
+		Subsystem->UnregisterInventory(Inventory);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
\ No newline at end of file
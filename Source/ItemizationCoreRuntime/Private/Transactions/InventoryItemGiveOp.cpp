@@ -0,0 +1,38 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Transactions/InventoryItemGiveOp.h"
+
+#include "Inventory/InventoryBase.h"
+#include "Transactions/InventoryTransaction_GiveRemoveItem.h"
+
+#define LOCTEXT_NAMESPACE "InventoryItemGiveOp"
+
+TInventoryTransactionResult<FInventoryItemGiveOp> FInventoryItemGiveOp::Execute(AInventoryBase& Inventory, const Params& InParams)
+{
+	if (InParams.ItemDefinition.IsExplicitlyNull() || InParams.StackCount <= 0)
+	{
+		return TInventoryTransactionResult<FInventoryItemGiveOp>(MakeInventoryError(
+			FString::Printf(TEXT("Invalid give params for inventory %s"), *GetNameSafe(&Inventory)),
+			LOCTEXT("InvalidParams", "Invalid item or stack count.")));
+	}
+
+	// The op might have been queued from another thread, the definition could be gone by now
+	UItemDefinitionBase* ItemDefinition = InParams.ItemDefinition.Get();
+	if (ItemDefinition == nullptr)
+	{
+		return TInventoryTransactionResult<FInventoryItemGiveOp>(MakeInventoryError(
+			FString::Printf(TEXT("Item definition of a pending give for inventory %s has been destroyed"), *GetNameSafe(&Inventory)),
+			LOCTEXT("StaleDefinition", "The item no longer exists.")));
+	}
+
+	FInventoryItemEntry ItemEntry(ItemDefinition, InParams.StackCount, InParams.SourceObject.Get());
+	FInventoryTransaction_GiveRemoveItem Transaction(nullptr, &Inventory, InParams.StackCount);
+
+	Result OpResult;
+	OpResult.ItemHandle = Inventory.GiveItem(ItemEntry, OpResult.Excess, Transaction);
+
+	return TInventoryTransactionResult<FInventoryItemGiveOp>(MoveTemp(OpResult));
+}
+
+#undef LOCTEXT_NAMESPACE
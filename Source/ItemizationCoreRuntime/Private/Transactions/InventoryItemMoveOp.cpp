@@ -3,4 +3,59 @@
 
 #include "Transactions/InventoryItemMoveOp.h"
 
+#include "ItemizationGameplayTags.h"
+#include "Inventory/InventoryBase.h"
+#include "Transactions/InventoryTransaction_GiveRemoveItem.h"
 
+#define LOCTEXT_NAMESPACE "InventoryItemMoveOp"
+
+TInventoryTransactionResult<FInventoryItemMoveOp> FInventoryItemMoveOp::Execute(AInventoryBase& Inventory, const Params& InParams)
+{
+	AInventoryBase* SourceInventory = InParams.SourceInventory.IsExplicitlyNull() ? &Inventory : InParams.SourceInventory.Get();
+	AInventoryBase* TargetInventory = InParams.TargetInventory.Get();
+	if (SourceInventory == nullptr || TargetInventory == nullptr)
+	{
+		return TInventoryTransactionResult<FInventoryItemMoveOp>(MakeInventoryError(
+			FString::Printf(TEXT("Invalid source or target inventory when moving item [%s]"), *InParams.ItemHandle.ToString()),
+			LOCTEXT("InvalidInventory", "Invalid source or target inventory.")));
+	}
+
+	const FInventoryItemEntry* SourceEntry = SourceInventory->FindItemEntryFromHandle(InParams.ItemHandle);
+	if (SourceEntry == nullptr)
+	{
+		return TInventoryTransactionResult<FInventoryItemMoveOp>(MakeInventoryError(
+			FString::Printf(TEXT("Item [%s] not found in inventory %s"), *InParams.ItemHandle.ToString(), *GetNameSafe(SourceInventory)),
+			LOCTEXT("ItemNotFound", "The item could not be found.")));
+	}
+
+	Result OpResult;
+
+	// Moving within the same inventory doesn't change anything
+	if (SourceInventory == TargetInventory)
+	{
+		OpResult.TargetItemHandle = InParams.ItemHandle;
+		return TInventoryTransactionResult<FInventoryItemMoveOp>(MoveTemp(OpResult));
+	}
+
+	const int32 StackCount = SourceEntry->GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+	const int32 Delta = InParams.Delta <= 0 ? StackCount : FMath::Min(InParams.Delta, StackCount);
+
+	// Give to the target first, so only what it actually accepted leaves the source.
+	// The moved items keep their stats and a copy of the instance, entire stacks are taken over as they are.
+	const FInventoryItemEntry ItemEntry = SourceInventory->MakeTransferEntry(*SourceEntry, Delta, TargetInventory);
+	FInventoryTransaction_GiveRemoveItem GiveTransaction(nullptr, TargetInventory, Delta, InParams.Context);
+	OpResult.TargetItemHandle = TargetInventory->GiveTransferredItem(ItemEntry, OpResult.Excess, GiveTransaction);
+
+	const int32 NumMoved = Delta - OpResult.Excess;
+	if (NumMoved > 0)
+	{
+		FInventoryTransaction_GiveRemoveItem RemoveTransaction(nullptr, SourceInventory, NumMoved, InParams.Context);
+
+		int32 Missing = 0;
+		SourceInventory->RemoveItem(InParams.ItemHandle, RemoveTransaction, Missing);
+	}
+
+	return TInventoryTransactionResult<FInventoryItemMoveOp>(MoveTemp(OpResult));
+}
+
+#undef LOCTEXT_NAMESPACE
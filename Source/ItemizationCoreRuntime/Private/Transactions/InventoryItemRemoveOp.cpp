@@ -0,0 +1,26 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Transactions/InventoryItemRemoveOp.h"
+
+#include "Inventory/InventoryBase.h"
+#include "Transactions/InventoryTransaction_GiveRemoveItem.h"
+
+#define LOCTEXT_NAMESPACE "InventoryItemRemoveOp"
+
+TInventoryTransactionResult<FInventoryItemRemoveOp> FInventoryItemRemoveOp::Execute(AInventoryBase& Inventory, const Params& InParams)
+{
+	FInventoryTransaction_GiveRemoveItem Transaction(nullptr, &Inventory, InParams.Delta);
+
+	Result OpResult;
+	if (!Inventory.RemoveItem(InParams.ItemHandle, Transaction, OpResult.Missing))
+	{
+		return TInventoryTransactionResult<FInventoryItemRemoveOp>(MakeInventoryError(
+			FString::Printf(TEXT("Item [%s] not found in inventory %s"), *InParams.ItemHandle.ToString(), *GetNameSafe(&Inventory)),
+			LOCTEXT("ItemNotFound", "The item could not be found.")));
+	}
+
+	return TInventoryTransactionResult<FInventoryItemRemoveOp>(MoveTemp(OpResult));
+}
+
+#undef LOCTEXT_NAMESPACE
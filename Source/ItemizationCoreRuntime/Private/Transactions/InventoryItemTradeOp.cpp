@@ -0,0 +1,222 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Transactions/InventoryItemTradeOp.h"
+
+#include "ItemizationGameplayTags.h"
+#include "ItemizationLogChannels.h"
+#include "Inventory/InventoryBase.h"
+#include "Transactions/InventoryTransaction_GiveRemoveItem.h"
+
+#define LOCTEXT_NAMESPACE "InventoryItemTradeOp"
+
+namespace UE::ItemizationCore::Trade
+{
+	/** Everything one side of the trade hands over, staged before anything is committed. */
+	struct FStagedSide
+	{
+		AInventoryBase* Inventory = nullptr;
+
+		/** Number of items leaving the inventory per handle. */
+		TMap<FInventoryItemHandle, int32> OutgoingCounts;
+
+		/** Entries the other side receives, in the order of the offers. See AInventoryBase::MakeTransferEntry. */
+		TArray<FInventoryItemEntry> OutgoingEntries;
+
+		/** Handles of the offered entries, in the order of the offers. */
+		TArray<FInventoryItemHandle> OutgoingSources;
+	};
+
+	/** Resolves the offers of one side against its inventory. Returns an error if any offer can't be fulfilled. */
+	static TOptional<FInventoryError> StageSide(AInventoryBase& Inventory, TConstArrayView<FInventoryTradeOffer> Offers, FStagedSide& OutSide)
+	{
+		OutSide.Inventory = &Inventory;
+		OutSide.OutgoingEntries.Reserve(Offers.Num());
+		OutSide.OutgoingSources.Reserve(Offers.Num());
+
+		for (const FInventoryTradeOffer& Offer : Offers)
+		{
+			const FInventoryItemEntry* Entry = Inventory.FindItemEntryFromHandle(Offer.ItemHandle);
+			if (Entry == nullptr || Entry->ItemDefinition == nullptr)
+			{
+				return MakeInventoryError(
+					FString::Printf(TEXT("Offered item [%s] not found in inventory %s"), *Offer.ItemHandle.ToString(), *GetNameSafe(&Inventory)),
+					LOCTEXT("ItemNotFound", "An offered item could not be found."));
+			}
+
+			const int32 StackCount = Entry->GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+			const int32 Count = Offer.Count <= 0 ? StackCount : Offer.Count;
+
+			// The same stack might be offered more than once, so check against everything offered from it so far
+			int32& TotalCount = OutSide.OutgoingCounts.FindOrAdd(Offer.ItemHandle);
+			TotalCount += Count;
+			if (Count <= 0 || TotalCount > StackCount)
+			{
+				return MakeInventoryError(
+					FString::Printf(TEXT("Offered %d of item [%s], but inventory %s only holds %d"), TotalCount, *Offer.ItemHandle.ToString(), *GetNameSafe(&Inventory), StackCount),
+					LOCTEXT("NotEnoughItems", "Not enough items to trade."));
+			}
+
+			// Instances are only duplicated once the trade passed validation
+			OutSide.OutgoingEntries.Add(Inventory.MakeTransferEntry(*Entry, Count, nullptr));
+			OutSide.OutgoingSources.Add(Offer.ItemHandle);
+		}
+
+		return {};
+	}
+
+	/** Hands a copy of the instance of every offered entry over to the receiving side, before anything leaves the giving side. */
+	static void CarryInstances(FStagedSide& Giver, const FStagedSide& Receiver)
+	{
+		for (int32 Idx = 0; Idx < Giver.OutgoingEntries.Num(); ++Idx)
+		{
+			const FInventoryItemEntry* Entry = Giver.Inventory->FindItemEntryFromHandle(Giver.OutgoingSources[Idx]);
+			if (Entry && Entry->GetItemInstance())
+			{
+				const int32 Count = Giver.OutgoingEntries[Idx].GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+				Giver.OutgoingEntries[Idx] = Giver.Inventory->MakeTransferEntry(*Entry, Count, Receiver.Inventory);
+			}
+		}
+	}
+
+	/** Checks whether the receiving side has room for everything the giving side hands over. */
+	static TOptional<FInventoryError> ValidateCapacity(const FStagedSide& Receiver, const FStagedSide& Giver)
+	{
+		const int32 Excess = Receiver.Inventory->SimulateExchange(Giver.OutgoingEntries, Receiver.OutgoingCounts);
+		if (Excess > 0)
+		{
+			return MakeInventoryError(
+				FString::Printf(TEXT("Inventory %s has no room for %d of the traded items"), *GetNameSafe(Receiver.Inventory), Excess),
+				LOCTEXT("NoRoom", "Not enough room to receive the traded items."));
+		}
+
+		return {};
+	}
+
+	/** Removes everything the side hands over from its inventory. */
+	static void CommitOutgoing(const FStagedSide& Side, FGameplayTagContainer* Context)
+	{
+		for (const TPair<FInventoryItemHandle, int32>& Pair : Side.OutgoingCounts)
+		{
+			FInventoryTransaction_GiveRemoveItem Transaction(nullptr, Side.Inventory, Pair.Value, Context);
+
+			int32 Missing = 0;
+			Side.Inventory->RemoveItem(Pair.Key, Transaction, Missing);
+			ensureMsgf(Missing == 0, TEXT("Trade removed %d items less than validated from %s."), Missing, *GetNameSafe(Side.Inventory));
+		}
+	}
+
+	/** Gives everything the giver hands over to the receiver. Returns the handles of the receiving entries. */
+	static TArray<FInventoryItemHandle> CommitIncoming(const FStagedSide& Receiver, const FStagedSide& Giver, FGameplayTagContainer* Context)
+	{
+		TArray<FInventoryItemHandle> ReceivedHandles;
+		ReceivedHandles.Reserve(Giver.OutgoingEntries.Num());
+
+		for (const FInventoryItemEntry& Entry : Giver.OutgoingEntries)
+		{
+			const int32 Count = Entry.GetStatValue(Itemization::Tags::TAG_ItemStat_CurrentStackSize);
+			FInventoryTransaction_GiveRemoveItem Transaction(nullptr, Receiver.Inventory, Count, Context);
+
+			int32 Excess = 0;
+			ReceivedHandles.Add(Receiver.Inventory->GiveTransferredItem(Entry, Excess, Transaction));
+
+			// Validation should have caught this. Hand the rest back rather than destroying items
+			if (Excess > 0)
+			{
+				ITEMIZATION_WARN("Trade couldn't give %d of %s to %s after validation passed, returning them to %s.",
+					Excess, *GetNameSafe(Entry.ItemDefinition), *GetNameSafe(Receiver.Inventory), *GetNameSafe(Giver.Inventory));
+
+				const FInventoryItemEntry ReturnedEntry = Receiver.Inventory->MakeTransferEntry(Entry, Excess, Giver.Inventory);
+				FInventoryTransaction_GiveRemoveItem ReturnTransaction(nullptr, Giver.Inventory, Excess, Context);
+
+				int32 ReturnExcess = 0;
+				Giver.Inventory->GiveTransferredItem(ReturnedEntry, ReturnExcess, ReturnTransaction);
+			}
+		}
+
+		return ReceivedHandles;
+	}
+}
+
+bool FInventoryItemTradeOp::CommitsBefore(const AInventoryBase& First, const AInventoryBase& Second)
+{
+	const FGuid& FirstGuid = First.InventoryHandle.GetGuid();
+	const FGuid& SecondGuid = Second.InventoryHandle.GetGuid();
+
+	// Inventories that haven't been assigned to a handle still need a stable order
+	if (!FirstGuid.IsValid() || !SecondGuid.IsValid())
+	{
+		return First.GetUniqueID() < Second.GetUniqueID();
+	}
+
+	return FirstGuid < SecondGuid;
+}
+
+TInventoryTransactionResult<FInventoryItemTradeOp> FInventoryItemTradeOp::Execute(AInventoryBase& Inventory, const Params& InParams)
+{
+	using namespace UE::ItemizationCore::Trade;
+
+	AInventoryBase* InventoryA = InParams.InventoryA.IsExplicitlyNull() ? &Inventory : InParams.InventoryA.Get();
+	AInventoryBase* InventoryB = InParams.InventoryB.Get();
+	if (InventoryA == nullptr || InventoryB == nullptr || InventoryA == InventoryB)
+	{
+		return TInventoryTransactionResult<FInventoryItemTradeOp>(MakeInventoryError(
+			FString::Printf(TEXT("Invalid trade between %s and %s"), *GetNameSafe(InventoryA), *GetNameSafe(InventoryB)),
+			LOCTEXT("InvalidInventory", "Invalid trade partners.")));
+	}
+
+	// Stage and validate both sides before touching any of them
+	FStagedSide SideA;
+	FStagedSide SideB;
+
+	TOptional<FInventoryError> Error = StageSide(*InventoryA, InParams.OffersA, SideA);
+	if (!Error.IsSet())
+	{
+		Error = StageSide(*InventoryB, InParams.OffersB, SideB);
+	}
+	if (!Error.IsSet())
+	{
+		Error = ValidateCapacity(SideA, SideB);
+	}
+	if (!Error.IsSet())
+	{
+		Error = ValidateCapacity(SideB, SideA);
+	}
+	if (Error.IsSet())
+	{
+		return TInventoryTransactionResult<FInventoryItemTradeOp>(MoveTemp(Error.GetValue()));
+	}
+
+	CarryInstances(SideA, SideB);
+	CarryInstances(SideB, SideA);
+
+	// Commit in a deterministic order, so two trades between the same inventories always apply in the same order
+	const bool bAFirst = CommitsBefore(*InventoryA, *InventoryB);
+	const FStagedSide& First = bAFirst ? SideA : SideB;
+	const FStagedSide& Second = bAFirst ? SideB : SideA;
+
+	First.Inventory->BeginDeferredNotifications();
+	Second.Inventory->BeginDeferredNotifications();
+
+	// Everything leaves first, so the freed up room is available to what comes in
+	CommitOutgoing(First, InParams.Context);
+	CommitOutgoing(Second, InParams.Context);
+
+	Result OpResult;
+	TArray<FInventoryItemHandle> ReceivedByFirst = CommitIncoming(First, Second, InParams.Context);
+	TArray<FInventoryItemHandle> ReceivedBySecond = CommitIncoming(Second, First, InParams.Context);
+	OpResult.ReceivedByA = bAFirst ? MoveTemp(ReceivedByFirst) : MoveTemp(ReceivedBySecond);
+	OpResult.ReceivedByB = bAFirst ? MoveTemp(ReceivedBySecond) : MoveTemp(ReceivedByFirst);
+
+	// Both sides are applied, listeners may observe them now
+	First.Inventory->EndDeferredNotifications();
+	Second.Inventory->EndDeferredNotifications();
+
+	// Deliver the trade as a single change set per inventory
+	First.Inventory->FlushChangeSet();
+	Second.Inventory->FlushChangeSet();
+
+	return TInventoryTransactionResult<FInventoryItemTradeOp>(MoveTemp(OpResult));
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
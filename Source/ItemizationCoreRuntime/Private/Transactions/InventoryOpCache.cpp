@@ -3,3 +3,94 @@
 
 #include "Transactions/InventoryOpCache.h"
 
+#include "ItemizationStats.h"
+#include "Inventory/InventoryBase.h"
+
+void FInventoryOpCache::ExecutePendingOperations(AInventoryBase& Inventory)
+{
+	ITEMIZATION_SCOPE_CYCLE_COUNTER(ExecutePendingOperations);
+	check(IsInGameThread());
+
+	// Only drain what is there right now, operations might queue up follow-up operations
+	TArray<TUniquePtr<IPendingInventoryOp>, TInlineAllocator<16>> Batch;
+	for (int32 NumToExecute = NumPendingOperations.load(); NumToExecute > 0; --NumToExecute)
+	{
+		TUniquePtr<IPendingInventoryOp> Operation;
+		if (!PendingOperations.Dequeue(Operation))
+		{
+			break;
+		}
+
+		NumPendingOperations.fetch_sub(1);
+		Batch.Add(MoveTemp(Operation));
+	}
+
+	if (Batch.IsEmpty())
+	{
+		return;
+	}
+
+	ITEMIZATION_INC_STAT_BY(NumOperations, Batch.Num());
+
+	FInventoryMetrics& Metrics = Inventory.GetMetrics();
+	for (const TUniquePtr<IPendingInventoryOp>& Operation : Batch)
+	{
+		Metrics.RecordOp(Operation->GetOpTypeName());
+	}
+
+	// Group operations of the same type and coalescing key, keeping the order of their first occurrence
+	TArray<TArray<IPendingInventoryOp*, TInlineAllocator<4>>, TInlineAllocator<16>> Groups;
+	TMap<TPair<UPTRINT, uint64>, int32, TInlineSetAllocator<16>> GroupIndices;
+	for (const TUniquePtr<IPendingInventoryOp>& Operation : Batch)
+	{
+		const uint64 CoalescingKey = Operation->GetCoalescingKey();
+		if (CoalescingKey == 0)
+		{
+			Groups.AddDefaulted_GetRef().Add(Operation.Get());
+			continue;
+		}
+
+		const TPair<UPTRINT, uint64> GroupKey(Operation->GetOpTypeKey(), CoalescingKey);
+		if (const int32* GroupIdx = GroupIndices.Find(GroupKey))
+		{
+			// Keys might collide, ops that don't actually match the group run on their own
+			if (Groups[*GroupIdx][0]->CanCoalesceWith(*Operation))
+			{
+				Groups[*GroupIdx].Add(Operation.Get());
+			}
+			else
+			{
+				Groups.AddDefaulted_GetRef().Add(Operation.Get());
+			}
+		}
+		else
+		{
+			GroupIndices.Add(GroupKey, Groups.Num());
+			Groups.AddDefaulted_GetRef().Add(Operation.Get());
+		}
+	}
+
+	// The ops have been counted above, the gives and removes they run don't count again
+	FInventoryMetrics::FScopedQueuedOps QueuedOpsScope(Metrics);
+	for (const TArray<IPendingInventoryOp*, TInlineAllocator<4>>& Group : Groups)
+	{
+		if (Group.Num() == 1)
+		{
+			Group[0]->Execute(&Inventory);
+		}
+		else
+		{
+			Group[0]->ExecuteCoalesced(Inventory, MakeArrayView(Group).RightChop(1));
+		}
+	}
+}
+
+void FInventoryOpCache::CancelPendingOperations()
+{
+	TUniquePtr<IPendingInventoryOp> Operation;
+	while (PendingOperations.Dequeue(Operation))
+	{
+		NumPendingOperations.fetch_sub(1);
+		Operation->Execute(nullptr);
+	}
+}
@@ -0,0 +1,136 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Transactions/InventoryRequest.h"
+
+#include "ItemizationSerializationUtils.h"
+#include "Engine/PackageMapClient.h"
+#include "Inventory/InventoryBase.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryRequest)
+
+namespace UE::ItemizationCore::Net
+{
+	using UE::ItemizationCore::SerializeZigZag;
+
+	/** Writes an index that might be INDEX_NONE as varint. */
+	static void SerializeIndex(FArchive& Ar, int32& Index)
+	{
+		uint32 Encoded = static_cast<uint32>(Index + 1);
+		Ar.SerializeIntPacked(Encoded);
+		Index = static_cast<int32>(Encoded) - 1;
+	}
+}
+
+bool FInventoryRequest::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace UE::ItemizationCore::Net;
+
+	uint8 TypeByte = static_cast<uint8>(Type);
+	Ar << TypeByte;
+	if (TypeByte >= static_cast<uint8>(EInventoryRequestType::MAX))
+	{
+		bOutSuccess = false;
+		return false;
+	}
+
+	Type = static_cast<EInventoryRequestType>(TypeByte);
+	ItemHandle.SerializePacked(Ar);
+
+	switch (Type)
+	{
+	case EInventoryRequestType::Remove:
+		SerializeZigZag(Ar, Delta);
+		break;
+
+	case EInventoryRequestType::Move:
+		{
+			SerializeZigZag(Ar, Delta);
+
+			UObject* Target = TargetInventory.Get();
+			bOutSuccess &= Map->SerializeObject(Ar, AInventoryBase::StaticClass(), Target);
+			TargetInventory = Cast<AInventoryBase>(Target);
+		}
+		break;
+
+	case EInventoryRequestType::Place:
+		{
+			GroupTag.NetSerialize(Ar, Map, bOutSuccess);
+			SerializeIndex(Ar, SlotOrigin.RowIndex);
+			SerializeIndex(Ar, SlotOrigin.ColumnIndex);
+
+			uint8 bRotatedBit = bRotated ? 1 : 0;
+			Ar.SerializeBits(&bRotatedBit, 1);
+			bRotated = bRotatedBit != 0;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return !Ar.IsError();
+}
+
+bool FInventoryRequestBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	Ar.SerializeIntPacked(BatchId);
+
+	uint32 NumRequests = Requests.Num();
+	Ar.SerializeIntPacked(NumRequests);
+
+	// Don't let a client make us allocate arbitrary amounts of memory
+	if (NumRequests > static_cast<uint32>(MaxNumRequests))
+	{
+		bOutSuccess = false;
+		Ar.SetError();
+		return false;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Requests.SetNum(NumRequests);
+	}
+
+	for (FInventoryRequest& Request : Requests)
+	{
+		if (!Request.NetSerialize(Ar, Map, bOutSuccess) || !bOutSuccess)
+		{
+			bOutSuccess = false;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FInventoryRequestAck::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	Ar.SerializeIntPacked(BatchId);
+
+	uint32 NumResults = Results.Num();
+	Ar.SerializeIntPacked(NumResults);
+	if (NumResults > static_cast<uint32>(FInventoryRequestBatch::MaxNumRequests))
+	{
+		bOutSuccess = false;
+		Ar.SetError();
+		return false;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Results.SetNum(NumResults);
+	}
+
+	// Two bits per result are enough
+	for (EInventoryRequestResult& Result : Results)
+	{
+		uint8 ResultBits = static_cast<uint8>(Result);
+		Ar.SerializeBits(&ResultBits, 2);
+		Result = static_cast<EInventoryRequestResult>(ResultBits & 0x3);
+	}
+
+	return !Ar.IsError();
+}
@@ -0,0 +1,109 @@
+// Author: Tom Werner (MajorT), 2025
+
+
+#include "Transactions/InventoryRequestLimiter.h"
+
+#include "ItemizationCoreSettings.h"
+#include "Engine/NetConnection.h"
+#include "Transactions/InventoryRequest.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InventoryRequestLimiter)
+
+void FInventoryRequestTokenBucket::Refill(const FInventoryRequestBudget& Budget, double CurrentTime)
+{
+	// New buckets start full, so regular play never starts out limited
+	if (LastRefillTime < 0.0)
+	{
+		Tokens = Budget.Capacity;
+		LastRefillTime = CurrentTime;
+		return;
+	}
+
+	const double ElapsedTime = FMath::Max(CurrentTime - LastRefillTime, 0.0);
+	Tokens = FMath::Min(Tokens + static_cast<float>(ElapsedTime) * Budget.RefillRate, Budget.Capacity);
+	LastRefillTime = CurrentTime;
+}
+
+FInventoryRequestLimiter& FInventoryRequestLimiter::Get()
+{
+	check(IsInGameThread());
+
+	static FInventoryRequestLimiter Limiter;
+	return Limiter;
+}
+
+float FInventoryRequestLimiter::GetRequestCost(EInventoryRequestType Type)
+{
+	const UItemizationCoreSettings* Settings = UItemizationCoreSettings::Get();
+
+	switch (Type)
+	{
+	case EInventoryRequestType::Remove:
+		return Settings->RemoveRequestCost;
+	case EInventoryRequestType::Move:
+		return Settings->MoveRequestCost;
+	case EInventoryRequestType::Place:
+		return Settings->PlaceRequestCost;
+	default:
+		return 0.f;
+	}
+}
+
+FInventoryRequestTokenBucket& FInventoryRequestLimiter::GetConnectionBucket(const UNetConnection* Connection, double CurrentTime)
+{
+	check(Connection);
+
+	FConnectionState* State = Connections.Find(Connection);
+	if (State == nullptr)
+	{
+		// Only bother cleaning up when a new connection comes in
+		RemoveStaleConnections();
+		State = &Connections.Add(Connection);
+	}
+
+	State->Bucket.Refill(UItemizationCoreSettings::Get()->ConnectionRequestBudget, CurrentTime);
+	return State->Bucket;
+}
+
+bool FInventoryRequestLimiter::RecordDroppedRequests(const UNetConnection* Connection, int32 NumDropped, double CurrentTime, uint64& OutNumDroppedSinceWarning)
+{
+	TotalNumDroppedRequests += NumDropped;
+	OutNumDroppedSinceWarning = NumDropped;
+
+	FConnectionState* State = Connections.Find(Connection);
+	if (State == nullptr)
+	{
+		return true;
+	}
+
+	State->NumDroppedRequests += NumDropped;
+	State->NumDroppedSinceWarning += NumDropped;
+
+	if (CurrentTime - State->LastWarningTime < DroppedRequestsWarningInterval)
+	{
+		return false;
+	}
+
+	OutNumDroppedSinceWarning = State->NumDroppedSinceWarning;
+	State->NumDroppedSinceWarning = 0;
+	State->LastWarningTime = CurrentTime;
+	return true;
+}
+
+uint64 FInventoryRequestLimiter::GetNumDroppedRequests(const UNetConnection* Connection) const
+{
+	const FConnectionState* State = Connections.Find(Connection);
+	return State ? State->NumDroppedRequests : 0;
+}
+
+void FInventoryRequestLimiter::RemoveStaleConnections()
+{
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		const UNetConnection* Connection = It.Key().ResolveObjectPtr();
+		if (Connection == nullptr || Connection->GetConnectionState() == USOCK_Closed)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
\ No newline at end of file
@@ -9,8 +9,19 @@
 #include "Components/GameFrameworkComponent.h"
 #include "Interfaces/InventoryOwnerInterface.h"
 #include "Items/InventoryItemSlot.h"
+#include "Tasks/Task.h"
+#include "Transactions/InventoryRequest.h"
+#include "Transactions/InventoryRequestLimiter.h"
 #include "InventoryComponent.generated.h"
 
+class UInventoryDefinition;
+
+/** Delegate called on the requesting client once the server acknowledged a batch of requests. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FInventoryRequestAckEvent, const FInventoryRequestAck&)
+
+/** Delegate called once an asynchronous inventory save has been written. */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FInventorySavedDynamicDelegate, bool, bSuccess);
+
 
 /** Base class for all inventory managers. */
 UCLASS(Config=Game, ClassGroup=(Inventory), meta=(BlueprintSpawnableComponent), Abstract)
@@ -39,12 +50,134 @@ public:
 	virtual void PostNetReceive() override;
 	virtual void OnRegister() override;
 	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 #if WITH_EDITOR
 	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
 #endif
 	//~ End UObject Interface
 
+	/** Returns the slot group of the given type or nullptr if this inventory doesn't have one. */
+	const FInventoryItemSlotGroup* FindSlotGroup(const FGameplayTag& GroupTag) const;
+	FInventoryItemSlotGroup* FindSlotGroup(const FGameplayTag& GroupTag);
+
+	/** Finds the first free slot in the given slot group. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	bool FindFirstFreeSlot(FGameplayTag GroupTag, FInventorySlotHandle& OutSlotHandle) const;
+
+	/** Returns true if the given slot group has at least NumSlots free slots. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	bool HasRoomInGroup(FGameplayTag GroupTag, int32 NumSlots = 1) const;
+
+	/**
+	 * Binds this component to its entry of an inventory definition. The properties of the entry, like its slot limit,
+	 * are applied to the inventory once it has been created, or right away if it already exists.
+	 */
+	void SetInventoryDefinition(const UInventoryDefinition* InInventoryDefinition, int32 InRoutingIndex);
+
+	/** Returns the inventory definition this component has been bound to or nullptr. */
+	const UInventoryDefinition* GetInventoryDefinition() const { return InventoryDefinition; }
+
+	/** Returns true if the inventory config marks this inventory as persistent across game sessions. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	bool IsPersistent() const;
+
+	/** Writes all persistent items of the inventory into a compact binary save. Returns false if the inventory isn't persistent. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool SaveInventory(TArray<uint8>& OutData) const;
+
+	/** Restores the inventory from a binary save. The inventory has to be empty. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool LoadInventory(const TArray<uint8>& Data);
+
+	/**
+	 * Saves all persistent items to Saved/Inventories/<SaveName> without blocking the game thread.
+	 * The inventory is captured right away, encoding, compression and writing happen on a background task.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool SaveInventoryAsync(const FString& SaveName, FInventorySavedDynamicDelegate OnSaved);
+
+	/** Restores the empty inventory from a save written by SaveInventoryAsync. Waits for pending saves of this inventory. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool LoadInventoryFromFile(const FString& SaveName);
+
+	/**
+	 * Exports the whole inventory including transient items and the slot group layout,
+	 * so it can be handed over to another server process.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool ExportInventory(TArray<uint8>& OutData) const;
+
+	/** Recreates a handed over inventory with the same item handles. The inventory has to be empty. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool ImportInventory(const TArray<uint8>& Data);
+
+	/**
+	 * Opens the local file journal with the given name, recovers the empty inventory from it and keeps journaling all changes.
+	 * Journals are stored in Saved/Inventories.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool OpenJournal(const FString& JournalName);
+
+	/** Writes all changes recorded since the last flush to the journal. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	bool FlushJournal();
+
+	/** ---------------------------------------------------------------------------------------------------------------
+	 * Client Requests
+	 *
+	 * Clients can't change their inventory directly, but request changes from the server.
+	 * All requests issued within a frame are packed into a single batch and sent with one RPC.
+	 * The server validates and applies the whole batch at once and replies with a single acknowledgement.
+	 -----------------------------------------------------------------------------------------------------------------*/
+
+	/** Queues a request for the next batch. Returns the index of the request within its batch. */
+	int32 QueueRequest(const FInventoryRequest& Request);
+
+	/** Requests removing items from a stack. Values <= 0 remove the entire stack. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	int32 RequestRemoveItem(FInventoryItemHandle ItemHandle, int32 Delta);
+
+	/** Requests moving items into another inventory of the same owner. Values <= 0 move the entire stack. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	int32 RequestMoveItem(FInventoryItemHandle ItemHandle, AInventoryBase* TargetInventory, int32 Delta);
+
+	/** Requests placing an item into a slot group. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	int32 RequestPlaceItem(FInventoryItemHandle ItemHandle, FGameplayTag GroupTag, FInventorySlotHandle Origin, bool bRotated);
+
+	/** Sends all queued requests right away instead of waiting for the end of the frame. */
+	void FlushRequests();
+
+	/** Returns the number of client requests to this inventory that have been dropped by the rate limiter. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	int64 GetNumDroppedRequests() const { return static_cast<int64>(NumDroppedRequests); }
+
+	/** Delegate called once the server acknowledged a batch of requests. */
+	FInventoryRequestAckEvent OnRequestsAcknowledgedDelegate;
+
+protected:
+	/** Server-side entry point for a batch of client requests. */
+	UFUNCTION(Server, Reliable)
+	void ServerProcessRequests(const FInventoryRequestBatch& Batch);
+
+	/** Acknowledges a processed batch on the requesting client. */
+	UFUNCTION(Client, Reliable)
+	void ClientAcknowledgeRequests(const FInventoryRequestAck& Ack);
+
+	/**
+	 * Validates and applies all requests of the batch.
+	 * Requests sent through a connection are charged against the request budgets first.
+	 * Requests exceeding a budget are rejected before they touch the inventory. Local requests are never limited.
+	 */
+	virtual FInventoryRequestAck ProcessRequestBatch(const FInventoryRequestBatch& Batch, UNetConnection* Connection);
+
+	/** Charges a request against the budgets of the connection and this inventory. Returns false if the request has to be dropped. */
+	virtual bool ConsumeRequestBudget(const FInventoryRequest& Request, FInventoryRequestTokenBucket& ConnectionBucket);
+
+	/** Validates and applies a single request. Override to restrict what clients are allowed to request. */
+	virtual EInventoryRequestResult ProcessRequest(const FInventoryRequest& Request);
+
 protected:
 	/** Creates the actual inventory actor storing it in the handle. */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
@@ -53,8 +186,12 @@ protected:
 	/** Called right after the inventory was spawned or set by replication. */
 	virtual void OnInventoryCreated(AInventoryBase* Inventory);
 
+	/** Creates the slot groups described by the inventory config. */
 	virtual void InitInventoryGroups();
 
+	/** Applies the properties of the bound inventory definition entry to the inventory. */
+	virtual void ApplyInventoryProperties(AInventoryBase* Inventory);
+
 protected:
 	/** The inventory class to use for this inventory manager. */
 	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly, Category = InventoryConfig)
@@ -68,6 +205,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = InventoryConfig)
 	TObjectPtr<UInventoryConfig> InventoryConfig;
 
+	/** Inventory definition this component has been bound to. */
+	UPROPERTY(Transient)
+	TObjectPtr<const UInventoryDefinition> InventoryDefinition;
+
+	/** Routing index of this component within the inventory definition. */
+	int32 InventoryDefinitionIndex = INDEX_NONE;
+
 	/** Handle that points to the inventory this manager is associated with. */
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing=OnRep_InventoryHandle, Category = Inventory)
 	FInventoryHandle InventoryHandle;
@@ -79,6 +223,23 @@ protected:
 	UFUNCTION()
 	virtual void OnRep_InventoryHandle();
 
+	/** Slot groups created from the inventory config, mapped by their group type. */
 	UPROPERTY()
 	TMap<FGameplayTag, FInventoryItemSlotGroup> ItemSlotGroups;
+
+private:
+	/** Requests waiting to be sent with the next batch. */
+	FInventoryRequestBatch PendingRequests;
+
+	/** Id of the next request batch. */
+	uint32 NextRequestBatchId = 1;
+
+	/** Request budget of this inventory. Only used on the server. */
+	FInventoryRequestTokenBucket RequestBucket;
+
+	/** Number of client requests to this inventory that have been dropped by the rate limiter. */
+	uint64 NumDroppedRequests = 0;
+
+	/** The last asynchronous save of this inventory. Following saves wait for it, so they are written in order. */
+	UE::Tasks::FTask PendingSave;
 };
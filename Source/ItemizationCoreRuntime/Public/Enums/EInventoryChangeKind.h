@@ -0,0 +1,25 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "EInventoryChangeKind.generated.h"
+
+/**
+ * Bitmask describing what happened to an item entry inside an inventory.
+ * Multiple kinds can be combined when several changes are aggregated into a single change set entry.
+ */
+UENUM(BlueprintType, meta=(Bitflags, UseEnumValuesAsMaskValuesInEditor="true"))
+enum class EInventoryChangeKind : uint8
+{
+	None = 0x0				UMETA(Hidden),
+
+	/** The item entry has been added to the inventory. */
+	Added = 0x1				UMETA(DisplayName = "Added"),
+
+	/** The item entry has been removed from the inventory. */
+	Removed = 0x2			UMETA(DisplayName = "Removed"),
+
+	/** The stack count of the item entry has changed. */
+	Changed = 0x4			UMETA(DisplayName = "Changed"),
+};
+ENUM_CLASS_FLAGS(EInventoryChangeKind)
\ No newline at end of file
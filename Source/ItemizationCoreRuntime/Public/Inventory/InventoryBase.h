@@ -5,18 +5,35 @@
 #include "CoreMinimal.h"
 #include "InventoryHandle.h"
 #include "GameFramework/Actor.h"
+#include "Inventory/InventoryChangeLog.h"
+#include "Inventory/InventoryChangeSet.h"
+#include "Inventory/InventoryEventDispatcher.h"
+#include "Inventory/InventoryMetrics.h"
+#include "Inventory/InventorySnapshot.h"
 #include "Items/InventoryItemEntry.h"
+#include "Persistence/InventoryJournal.h"
+#include "Transactions/InventoryItemGiveOp.h"
 #include "Transactions/InventoryItemMoveOp.h"
+#include "Transactions/InventoryItemRemoveOp.h"
+#include "Transactions/InventoryItemTradeOp.h"
 #include "Transactions/InventoryOpCache.h"
 #include "InventoryBase.generated.h"
 
 struct FInventoryItemMoveOp;
 struct FInventoryChangeMessage;
 struct FInventoryTransaction_GiveRemoveItem;
+class FInventorySerializer;
+class UItemDefinitionBase;
 
 /** Inventory item event delegate. */
 DECLARE_MULTICAST_DELEGATE_OneParam(FInventoryItemEvent, const FInventoryChangeMessage&)
 
+/** Inventory change set event delegate. Fires at most once per frame with all changes of that frame. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FInventoryChangeSetEvent, const FInventoryChangeSet&)
+
+/** Inventory total count event delegate. Passes the item definition, the new total and the old total. */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FInventoryTotalCountEvent, const UItemDefinitionBase*, int32, int32)
+
 #define MY_API ITEMIZATIONCORERUNTIME_API
 
 /** Inventory class that manages an inventory list. */
@@ -24,6 +41,10 @@ UCLASS(HideCategories=(Input,Movement,Collision,Rendering,Physics), BlueprintTyp
 class AInventoryBase : public AActor
 {
 	GENERATED_BODY()
+	friend struct FInventoryItemEntry;
+	friend class FInventorySerializer;
+	friend class FInventoryJournal;
+	friend class FGameplayDebuggerCategory_Inventory;
 
 public:
 	MY_API AInventoryBase(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
@@ -37,6 +58,8 @@ protected:
 
 	//~ Begin AActor Interface
 	MY_API virtual void PostInitializeComponents() override;
+	MY_API virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	MY_API virtual void Tick(float DeltaSeconds) override;
 	//~ End AActor Interface
 
 public:
@@ -64,13 +87,92 @@ public:
 	 *		– RemoveItem() Only the server can remove items.
 	 -----------------------------------------------------------------------------------------------------------------*/
 
+	/**
+	 * Queues an operation on this inventory. Can be called from any thread.
+	 * All queued operations are executed as one batch on the game thread at the end of the frame.
+	 * Use the returned handle to track the state of the operation.
+	 */
+	template <typename OpType>
+	TInventoryOpHandle<OpType> EnqueueOperation(typename OpType::Params&& Params)
+	{
+		bool bWasEmpty = false;
+		TInventoryOpHandle<OpType> Handle = OpCache.EnqueueOperation<OpType>(MoveTemp(Params), bWasEmpty);
+		if (bWasEmpty)
+		{
+			ScheduleOperationFlush();
+		}
+		return Handle;
+	}
+
+	/** Queues a give item operation. Can be called from any thread. */
+	TInventoryOpHandle<FInventoryItemGiveOp> EnqueueGiveItem(FInventoryItemGiveOp::Params&& Params)
+	{
+		return EnqueueOperation<FInventoryItemGiveOp>(MoveTemp(Params));
+	}
+
+	/** Queues a remove item operation. Can be called from any thread. */
+	TInventoryOpHandle<FInventoryItemRemoveOp> EnqueueRemoveItem(FInventoryItemRemoveOp::Params&& Params)
+	{
+		return EnqueueOperation<FInventoryItemRemoveOp>(MoveTemp(Params));
+	}
+
+	/** Queues a move item operation from the source to the target inventory. Can be called from any thread. */
 	MY_API virtual TInventoryOpHandle<FInventoryItemMoveOp> MoveItem(FInventoryItemMoveOp::Params&& Params);
 
+	/**
+	 * Queues an atomic trade between this and another inventory. Can be called from any thread.
+	 * Either both sides are applied or none of them. This inventory is side A unless specified otherwise.
+	 */
+	MY_API virtual TInventoryOpHandle<FInventoryItemTradeOp> TradeItems(FInventoryItemTradeOp::Params&& Params);
+
+	/** Executes all queued operations right away instead of waiting for the end of the frame. Game thread only. */
+	MY_API void ExecutePendingOperations();
+
+	/** Returns the number of queued operations that haven't been executed yet. */
+	int32 GetNumPendingOperations() const { return OpCache.GetNumPendingOperations(); }
+
+	/** Returns the item entry with the given handle or nullptr if it isn't part of this inventory. */
+	MY_API const FInventoryItemEntry* FindItemEntryFromHandle(const FInventoryItemHandle& ItemHandle) const;
+
+	/** Returns the number of item entries in this inventory. */
+	int32 GetNumItemEntries() const { return InventoryList.Num(); }
+
 	/** Adds an item to the inventory. */
 	MY_API virtual FInventoryItemHandle GiveItem(const FInventoryItemEntry& ItemEntry, int32& OutExcess, FInventoryTransaction_GiveRemoveItem& Transaction);
 
 	/** Removes an item from the inventory. */
 	MY_API virtual bool RemoveItem(const FInventoryItemHandle& ItemHandle, FInventoryTransaction_GiveRemoveItem& Transaction, int32& OutMissing);
+
+	/**
+	 * Returns a copy of one of our item entries holding StackCount items, to hand them over to another inventory.
+	 * The copy keeps all stats, item data and the source object. If a target is given, it carries a duplicate of the item instance
+	 * owned by the target. Entire stacks keep their item handle, so the target can take the entry over as it is.
+	 */
+	MY_API FInventoryItemEntry MakeTransferEntry(const FInventoryItemEntry& ItemEntry, int32 StackCount, AInventoryBase* TargetInventory) const;
+
+	/**
+	 * Gives an item entry handed over by another inventory. See MakeTransferEntry.
+	 * Entire stacks are taken over as a new stack with their handle, stats and instance. Partial stacks and
+	 * entire stacks that can't get a stack of their own are given like any other item, keeping their stats.
+	 */
+	MY_API FInventoryItemHandle GiveTransferredItem(const FInventoryItemEntry& TransferEntry, int32& OutExcess, FInventoryTransaction_GiveRemoveItem& Transaction);
+
+	/**
+	 * Dry run of an exchange that doesn't change anything.
+	 * Returns how many of the incoming items wouldn't fit, after the outgoing items per handle have left the inventory.
+	 * Incoming entries are expected to carry their stack size and max stack size stats.
+	 * Incoming entries with a valid handle are entire stacks handed over via MakeTransferEntry and need a stack of their own if possible.
+	 */
+	MY_API virtual int32 SimulateExchange(TConstArrayView<FInventoryItemEntry> IncomingEntries, const TMap<FInventoryItemHandle, int32>& OutgoingCounts) const;
+
+	/**
+	 * Holds back all item and total count notifications until the matching EndDeferredNotifications.
+	 * Used to apply several changes that must not be observed one by one. Scopes can be nested.
+	 */
+	MY_API void BeginDeferredNotifications();
+
+	/** Ends a deferred notification scope. Leaving the outermost scope delivers all held back notifications. */
+	MY_API void EndDeferredNotifications();
 	
 	MY_API virtual void OnRemoveItem(FInventoryItemEntry& ItemEntry);
 	MY_API virtual void OnGiveItem(FInventoryItemEntry& ItemEntry);
@@ -84,9 +186,74 @@ public:
 	/** Delegate that gets called whenever an item was changed. */
 	FInventoryItemEvent OnItemChangedDelegate;
 
+	/**
+	 * Delegate that gets called once per frame with the aggregated adds, removes and changes of that frame.
+	 * Changes are only collected while something is bound, so listeners that don't need per-entry events should prefer this.
+	 */
+	FInventoryChangeSetEvent OnChangeSetDelegate;
+
+	/** Immediately broadcasts all pending changes instead of waiting for the end of the frame. */
+	MY_API void FlushChangeSet();
+
+	/**
+	 * Subscribes to item changes matching the filter, e.g. a single item definition or a set of traits.
+	 * Unlike the item delegates above, the subscriber is only invoked for changes it is interested in.
+	 */
+	MY_API FDelegateHandle SubscribeToItemEvents(const FInventoryEventFilter& Filter, FInventoryFilteredItemEvent Delegate);
+
+	/** Removes a subscription previously added via SubscribeToItemEvents. */
+	MY_API bool UnsubscribeFromItemEvents(FDelegateHandle Handle);
+
+	/**
+	 * Returns the latest published snapshot of this inventory. Can be called from any thread.
+	 * Snapshots are republished once per frame after the inventory changed, starting with the first call to this function.
+	 * Changes of the current frame are not part of the snapshot until it is republished.
+	 * The first call off the game thread returns null, the initial snapshot is published on the game thread afterwards.
+	 * Trait bits for GetTotalCountWithTraits can be built on any thread via FItemComponentData_Traits::FindTraitBits.
+	 */
+	MY_API FInventorySnapshotPtr GetSnapshot() const;
+
+	/** Returns the versioned log of the latest item changes. */
+	const FInventoryChangeLog& GetChangeLog() const { return ChangeLog; }
+
+	/**
+	 * Returns all changes since the version of the cursor and advances it.
+	 * If this returns ResyncRequired, the consumer has to rebuild its state from the InventoryList and grab a new cursor.
+	 */
+	EInventoryChangeLogReadResult ReadChanges(FInventoryChangeCursor& Cursor, TArray<FInventoryChangeLogEntry>& OutChanges) const
+	{
+		return ChangeLog.ReadChanges(Cursor, OutChanges);
+	}
+
+	/** Attaches a write-ahead journal that records every item change of this inventory. Pass nullptr to detach it. */
+	MY_API void SetJournal(TSharedPtr<FInventoryJournal> InJournal);
+
+	/** Returns the attached write-ahead journal or nullptr if changes aren't journaled. */
+	FInventoryJournal* GetJournal() const { return Journal.Get(); }
+
+	/** Returns the runtime cost metrics of this inventory. */
+	const FInventoryMetrics& GetMetrics() const { return Metrics; }
+	FInventoryMetrics& GetMetrics() { return Metrics; }
+
+	/** Returns the total stack count of the given item definition summed up over all entries in this inventory. */
+	UFUNCTION(BlueprintCallable, Category=Inventory)
+	MY_API int32 GetTotalCount(const UItemDefinitionBase* ItemDefinition) const;
+
+	/** Delegate that gets called whenever the total count of an item definition has changed. */
+	FInventoryTotalCountEvent OnTotalCountChangedDelegate;
+
 	/** Handle for outside inventory access. Gets set by the inventory component. */
 	UPROPERTY()
 	FInventoryHandle InventoryHandle;
+
+	/** Sets the maximum number of stacks that count towards the inventory limit. Negative values mean no limit. */
+	MY_API void SetMaxNumSlots(int32 InMaxNumSlots);
+
+	/** Returns the maximum number of stacks that count towards the inventory limit. Negative values mean no limit. */
+	int32 GetMaxNumSlots() const { return MaxNumSlots; }
+
+	/** Returns the number of stacks that count towards the inventory limit. */
+	int32 GetNumLimitedSlots() const { return NumLimitedSlots; }
 	
 protected:
 	/** Evaluates the given ItemEntry and checks if it can be added to the inventory. */
@@ -117,6 +284,18 @@ protected:
 	MY_API virtual void NotifyItemRemoved(const FInventoryItemEntry& ItemEntry, const int32& LastCount, const int32& NewCount);
 	MY_API virtual void NotifyItemChanged(const FInventoryItemEntry& ItemEntry, const int32& LastCount, const int32& NewCount);
 
+	/** Makes sure the inventory ticks once to flush pending change sets and snapshots. */
+	MY_API void RequestFlush();
+
+	/** Same as RequestFlush, but can be called from any thread. */
+	MY_API void ScheduleOperationFlush();
+
+	/** Rebuilds the snapshot from the inventory list and publishes it. Game thread only. */
+	MY_API void PublishSnapshot();
+
+	/** Central entry point for all item changes. Builds the per-entry message and feeds the pending change set. */
+	MY_API virtual void RecordItemChange(const FInventoryItemEntry& ItemEntry, int32 LastCount, int32 NewCount, EInventoryChangeKind Kind);
+
 protected:
 	/** Replicated list of inventory item entries. */
 	UPROPERTY(BlueprintReadOnly, Transient, ReplicatedUsing=OnRep_InventoryList, Category=Inventory)
@@ -140,6 +319,9 @@ protected:
 	/** Removes an item instance from the replicated sub object list. */
 	void RemoveReplicatedItemInstance(UInventoryItemInstance* ItemInstance);
 
+	/** Takes over the instance an item entry carried over from another inventory. */
+	MY_API void AdoptItemInstance(FInventoryItemEntry& ItemEntry);
+
 	/**
 	 * Called to mark an item entry dirty for replication.
 	 * bWasAddOrChange is an important flag to determine whether the entire array needs to be replicated,
@@ -149,6 +331,12 @@ protected:
 	 * @param bWasAddOrChange	True, if the item was added or changed. False, if the item was removed.
 	 */
 	MY_API void MarkItemEntryDirty(FInventoryItemEntry& ItemEntry, bool bWasAddOrChange = false);
+
+	/** Applies a stack count delta to the running total of the given item definition. */
+	MY_API void UpdateTotalCount(const UItemDefinitionBase* ItemDefinition, int32 Delta);
+
+	/** Applies a stack delta to the running number of limited slots, if the item definition counts towards the limit. */
+	MY_API void UpdateNumLimitedSlots(const UItemDefinitionBase* ItemDefinition, int32 Delta);
 	
 private:
 	/** Returns the mutable full list of all item instances. */
@@ -156,6 +344,61 @@ private:
 
 	/** Cached inventory operations. */
 	FInventoryOpCache OpCache;
+
+	/** Maximum number of stacks that count towards the inventory limit. */
+	int32 MaxNumSlots = INDEX_NONE;
+
+	/** Changes of the current frame that haven't been broadcast yet. */
+	FInventoryChangeSet PendingChangeSet;
+
+	/** Filtered item event subscriptions. */
+	FInventoryEventDispatcher EventDispatcher;
+
+	/** Bounded log of the latest item changes. */
+	FInventoryChangeLog ChangeLog;
+
+	/** Optional write-ahead journal fed with every item change. */
+	TSharedPtr<FInventoryJournal> Journal;
+
+	/** Runtime cost metrics of this inventory. */
+	FInventoryMetrics Metrics;
+
+	/** The latest published snapshot. The pointer itself is guarded by SnapshotLock, the snapshot is immutable. */
+	FInventorySnapshotPtr Snapshot;
+	mutable FRWLock SnapshotLock;
+
+	/** Whether anyone has asked for a snapshot yet. Snapshots are only maintained after that. */
+	mutable std::atomic<bool> bWantsSnapshots = false;
+
+	/** Whether the inventory changed since the last snapshot was published. */
+	bool bSnapshotDirty = false;
+
+	/** Binding that republishes the snapshot once a new trait bit has been assigned. */
+	FDelegateHandle TraitBitAddedHandle;
+
+	/** Running total stack count per item definition. Kept in sync by the give/remove paths and replication callbacks. */
+	TMap<TObjectKey<UItemDefinitionBase>, int32> DefinitionTotals;
+
+	/** Running number of stacks that count towards the inventory limit. Kept in sync alongside DefinitionTotals. */
+	int32 NumLimitedSlots = 0;
+
+	/** Item change held back by a deferred notification scope. */
+	struct FDeferredItemChange
+	{
+		FInventoryItemEntry ItemEntry;
+		int32 LastCount = 0;
+		int32 NewCount = 0;
+		EInventoryChangeKind Kind = EInventoryChangeKind::None;
+	};
+
+	/** Depth of nested deferred notification scopes. */
+	int32 DeferredNotificationDepth = 0;
+
+	/** Item changes held back by the current deferred notification scope. */
+	TArray<FDeferredItemChange> DeferredItemChanges;
+
+	/** Totals of the item definitions before they first changed within the current deferred notification scope. */
+	TMap<TObjectKey<UItemDefinitionBase>, int32> DeferredOldTotals;
 };
 
 
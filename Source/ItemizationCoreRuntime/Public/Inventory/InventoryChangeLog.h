@@ -0,0 +1,101 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemHandle.h"
+#include "Enums/EInventoryChangeKind.h"
+
+/** A single change recorded in the inventory change log. */
+struct FInventoryChangeLogEntry
+{
+	/** Handle to the item entry that changed. */
+	FInventoryItemHandle ItemHandle;
+
+	/** What happened to the item entry. */
+	EInventoryChangeKind Kind = EInventoryChangeKind::None;
+
+	/** Version of the inventory after this change. */
+	uint64 Version = 0;
+};
+
+/** Position of a consumer in the change log. Holds the last version the consumer has seen. */
+struct FInventoryChangeCursor
+{
+	FInventoryChangeCursor() = default;
+	explicit FInventoryChangeCursor(uint64 InVersion)
+		: Version(InVersion)
+	{
+	}
+
+	/** The last version the consumer has processed. */
+	uint64 Version = 0;
+};
+
+/** Result of reading from the inventory change log. */
+enum class EInventoryChangeLogReadResult : uint8
+{
+	/** There were no changes since the cursor version. */
+	UpToDate,
+
+	/** All changes since the cursor version have been returned. */
+	Changes,
+
+	/** The cursor fell behind the window of the change log. The consumer has to do a full resync. */
+	ResyncRequired,
+};
+
+/**
+ * Bounded, versioned log of item changes.
+ * Every recorded change bumps the version. Only the latest Capacity changes are kept in a ring buffer,
+ * so consumers can cheaply pull everything that happened since the last version they've seen.
+ */
+class ITEMIZATIONCORERUNTIME_API FInventoryChangeLog
+{
+public:
+	FInventoryChangeLog() = default;
+	explicit FInventoryChangeLog(int32 InCapacity);
+
+	/** Resizes the ring buffer, dropping all recorded changes. The version is kept. */
+	void SetCapacity(int32 InCapacity);
+
+	/** Records a change and bumps the version. */
+	void Record(const FInventoryItemHandle& ItemHandle, EInventoryChangeKind Kind);
+
+	/**
+	 * Appends all changes after the cursor version to OutChanges and advances the cursor to the current version.
+	 * If the cursor fell behind the log window, nothing is returned and the cursor is left untouched.
+	 */
+	EInventoryChangeLogReadResult ReadChanges(FInventoryChangeCursor& Cursor, TArray<FInventoryChangeLogEntry>& OutChanges) const;
+
+	/** Returns the version of the latest change. 0 if nothing has been recorded yet. */
+	uint64 GetVersion() const
+	{
+		return Version;
+	}
+
+	/** Returns the oldest version that is still available in the log. */
+	uint64 GetOldestVersion() const
+	{
+		return Version - Num + 1;
+	}
+
+	/** Returns a cursor pointing at the current version. */
+	FInventoryChangeCursor MakeCursor() const
+	{
+		return FInventoryChangeCursor(Version);
+	}
+
+private:
+	/** Ring buffer of recorded changes. */
+	TArray<FInventoryChangeLogEntry> Entries;
+
+	/** Index the next change is written to. */
+	int32 Head = 0;
+
+	/** Number of valid changes in the ring buffer. */
+	int32 Num = 0;
+
+	/** Version of the latest change. */
+	uint64 Version = 0;
+};
\ No newline at end of file
@@ -0,0 +1,92 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemHandle.h"
+#include "Enums/EInventoryChangeKind.h"
+
+#include "InventoryChangeSet.generated.h"
+
+class AInventoryBase;
+class UItemDefinitionBase;
+
+/** Net change of a single item entry, aggregated over all changes that occurred within one frame. */
+USTRUCT(BlueprintType)
+struct FInventoryChangeSetEntry
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the net stack count delta of the item entry. */
+	int32 GetDelta() const
+	{
+		return NewStackCount - OldStackCount;
+	}
+
+	/** Returns true if the given change kind has been recorded for this entry. */
+	bool HasChangeKind(EInventoryChangeKind Kind) const
+	{
+		return EnumHasAnyFlags(static_cast<EInventoryChangeKind>(ChangeKinds), Kind);
+	}
+
+	/** Handle to the item entry that changed. Removed entries can no longer be resolved through it. */
+	UPROPERTY(BlueprintReadOnly, Category=ChangeSet)
+	FInventoryItemHandle ItemHandle;
+
+	/** The item definition of the item entry. */
+	UPROPERTY(BlueprintReadOnly, Category=ChangeSet)
+	TObjectPtr<UItemDefinitionBase> ItemDefinition = nullptr;
+
+	/** Stack count before the first change of this frame. */
+	UPROPERTY(BlueprintReadOnly, Category=ChangeSet)
+	int32 OldStackCount = 0;
+
+	/** Stack count after the last change of this frame. */
+	UPROPERTY(BlueprintReadOnly, Category=ChangeSet)
+	int32 NewStackCount = 0;
+
+	/** All kinds of changes that have been recorded for this entry. */
+	UPROPERTY(BlueprintReadOnly, Category=ChangeSet, meta=(Bitmask, BitmaskEnum="/Script/ItemizationCoreRuntime.EInventoryChangeKind"))
+	uint8 ChangeKinds = 0;
+};
+
+/** Batched message holding all item changes of an inventory that occurred within one frame. */
+USTRUCT(BlueprintType)
+struct ITEMIZATIONCORERUNTIME_API FInventoryChangeSet
+{
+	GENERATED_BODY()
+
+public:
+	/** Records a change of the given item entry, merging it with previous changes of the same entry. */
+	void RecordChange(
+		const FInventoryItemHandle& ItemHandle,
+		UItemDefinitionBase* ItemDefinition,
+		int32 OldStackCount,
+		int32 NewStackCount,
+		EInventoryChangeKind Kind);
+
+	/** Drops entries without a net effect, e.g. entries that have been added and removed within the same frame. */
+	void Compact();
+
+	/** Clears all recorded changes but keeps the allocations around. */
+	void Reset();
+
+	/** Returns true if no changes have been recorded. */
+	bool IsEmpty() const
+	{
+		return Entries.IsEmpty();
+	}
+
+	/** The inventory the changes occurred on. */
+	UPROPERTY(BlueprintReadOnly, Category=ChangeSet)
+	TWeakObjectPtr<AInventoryBase> Inventory = nullptr;
+
+	/** Net changes per item handle, in the order the handles have first been touched. */
+	UPROPERTY(BlueprintReadOnly, Category=ChangeSet)
+	TArray<FInventoryChangeSetEntry> Entries;
+
+private:
+	/** Maps item handles to their index in the Entries array. */
+	TMap<FInventoryItemHandle, int32> EntryIndices;
+};
\ No newline at end of file
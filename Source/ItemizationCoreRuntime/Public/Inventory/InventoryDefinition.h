@@ -5,10 +5,13 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "InventoryProperties.h"
+#include "InventoryRoutingTable.h"
 #include "Engine/DataAsset.h"
 
 #include "InventoryDefinition.generated.h"
 
+class UItemDefinitionBase;
+
 /** Class defining a single inventory in the game. */
 UCLASS(BlueprintType, Const, MinimalAPI)
 class UInventoryDefinition : public UDataAsset
@@ -31,4 +34,54 @@ public:
 	/** List of optional tags that can be used to identify this inventory. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Inventory)
 	FGameplayTagContainer GameplayTags;
+
+public:
+	/** Returns the total number of inventories, regular and equippable ones. */
+	int32 GetNumInventories() const
+	{
+		return InventoryList.Num() + EquippableInventoryList.Num();
+	}
+
+	/**
+	 * Returns the properties of the inventory at the given routing index.
+	 * Inventories are indexed with the InventoryList first, followed by the EquippableInventoryList.
+	 */
+	ITEMIZATIONCORERUNTIME_API const FInventoryPropertiesBase* GetInventoryProperties(int32 Index) const;
+
+	/**
+	 * Returns a bitmask of all inventories accepting the item. Bit N maps to GetInventoryProperties(N).
+	 * Only the first 64 inventories can be routed to, any further ones never accept items.
+	 */
+	ITEMIZATIONCORERUNTIME_API uint64 GetAcceptingInventories(const UItemDefinitionBase* ItemDefinition) const;
+
+	/**
+	 * Evaluates the routing of the given item definitions up front, so the first give of each item doesn't have to.
+	 * Call this while loading, e.g. with all item definitions the inventories are expected to hold. Game thread only.
+	 */
+	ITEMIZATIONCORERUNTIME_API void PrewarmRouting(TConstArrayView<const UItemDefinitionBase*> ItemDefinitions) const;
+
+	/** Returns the routing index of the first inventory accepting the item or INDEX_NONE. */
+	ITEMIZATIONCORERUNTIME_API int32 FindFirstAcceptingInventory(const UItemDefinitionBase* ItemDefinition) const;
+
+	/** Checks whether the inventory at the given routing index accepts the item. */
+	bool DoesInventoryAcceptItem(int32 Index, const UItemDefinitionBase* ItemDefinition) const
+	{
+		return Index >= 0 && Index < FInventoryRoutingTable::MaxNumInventories &&
+			(GetAcceptingInventories(ItemDefinition) & (uint64(1) << Index)) != 0;
+	}
+
+protected:
+	//~ Begin UObject Interface
+	ITEMIZATIONCORERUNTIME_API virtual void PostLoad() override;
+#if WITH_EDITOR
+	ITEMIZATIONCORERUNTIME_API virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~ End UObject Interface
+
+private:
+	/** Warns if there are more inventories than the routing table can address. */
+	void ValidateNumInventories() const;
+
+	/** Cached item requirement query results. */
+	mutable FInventoryRoutingTable RoutingTable;
 };
@@ -0,0 +1,114 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Enums/EInventoryChangeKind.h"
+#include "UObject/ObjectKey.h"
+
+struct FInventoryChangeMessage;
+class UItemDefinitionBase;
+
+/** Delegate bound by a single filtered inventory event subscription. */
+DECLARE_DELEGATE_OneParam(FInventoryFilteredItemEvent, const FInventoryChangeMessage&)
+
+/**
+ * Describes which item changes a subscriber is interested in.
+ * All criteria that are set have to match. A filter without any criteria receives every change.
+ * Traits are always matched exactly, parent tags of an item trait don't match.
+ */
+struct ITEMIZATIONCORERUNTIME_API FInventoryEventFilter
+{
+	/** Only receive changes of this item definition. */
+	const UItemDefinitionBase* ItemDefinition = nullptr;
+
+	/** Only receive changes of items that have at least one of these trait bits. See FItemComponentData_Traits::GetTraitBit. */
+	uint64 TraitBits = 0;
+
+	/** Only receive changes of items whose traits match this query. */
+	FGameplayTagQuery TraitQuery;
+
+	/** The kinds of changes to receive. */
+	EInventoryChangeKind ChangeKinds = EInventoryChangeKind::Added | EInventoryChangeKind::Removed | EInventoryChangeKind::Changed;
+
+	/** Creates a filter for a single item definition. */
+	static FInventoryEventFilter ForDefinition(const UItemDefinitionBase* InItemDefinition);
+
+	/**
+	 * Creates a filter for items having any of the given traits, compared by exact tag.
+	 * Falls back to an exact trait query if not all traits can be represented as trait bits.
+	 * Returns an invalid filter if none of the traits are valid.
+	 */
+	static FInventoryEventFilter ForTraits(const FGameplayTagContainer& InTraits);
+
+	/** Creates a filter for items whose traits match the given query. */
+	static FInventoryEventFilter ForQuery(const FGameplayTagQuery& InQuery);
+
+	/** Returns false if the filter can't match anything, e.g. a trait filter without any valid traits. */
+	bool IsValid() const { return bIsValid; }
+
+	/** Checks whether a change of the given item passes this filter. */
+	bool Matches(const UItemDefinitionBase* InItemDefinition, uint64 InTraitBits, EInventoryChangeKind Kind) const;
+
+private:
+	/** Set to false by factories that couldn't build the requested criteria, so the filter never widens to unfiltered. */
+	bool bIsValid = true;
+};
+
+/**
+ * Dispatches item changes only to subscribers whose filter matches.
+ * Subscriptions are indexed by item definition and trait bit, so subscribers for other items are never visited.
+ */
+class ITEMIZATIONCORERUNTIME_API FInventoryEventDispatcher
+{
+public:
+	/** Adds a new subscription. Returns the handle required to remove it again or an invalid handle if the filter is invalid. */
+	FDelegateHandle Subscribe(const FInventoryEventFilter& Filter, FInventoryFilteredItemEvent&& Delegate);
+
+	/** Removes the subscription with the given handle. Returns true if it was found. */
+	bool Unsubscribe(FDelegateHandle Handle);
+
+	/** Returns true if there is at least one subscription. */
+	bool HasSubscribers() const
+	{
+		return Subscriptions.Num() > 0;
+	}
+
+	/** Invokes all subscriptions whose filter matches the changed item. */
+	void Dispatch(const FInventoryChangeMessage& Message, const UItemDefinitionBase* ItemDefinition, EInventoryChangeKind Kind);
+
+private:
+	struct FSubscription
+	{
+		FDelegateHandle Handle;
+		FInventoryEventFilter Filter;
+		FInventoryFilteredItemEvent Delegate;
+	};
+
+	/** Collects the indices of all subscriptions matching the changed item. */
+	void GatherMatches(const UItemDefinitionBase* ItemDefinition, uint64 TraitBits, EInventoryChangeKind Kind, TArray<int32, TInlineAllocator<16>>& OutMatches) const;
+
+	/** Adds or removes the subscription index to or from the index it is sorted into. */
+	void IndexSubscription(int32 SubscriptionIdx);
+	void UnindexSubscription(int32 SubscriptionIdx);
+
+private:
+	/** All active subscriptions. */
+	TSparseArray<FSubscription> Subscriptions;
+
+	/** Subscriptions filtering by item definition. */
+	TMap<TObjectKey<UItemDefinitionBase>, TArray<int32, TInlineAllocator<2>>> DefinitionIndex;
+
+	/** Subscriptions filtering by trait bits, bucketed per bit. */
+	TMap<int32, TArray<int32, TInlineAllocator<2>>> TraitBitIndex;
+
+	/** Union of all trait bits any subscription is filtering for. */
+	uint64 SubscribedTraitBits = 0;
+
+	/** Subscriptions only filtering by a trait query. These have to be evaluated one by one. */
+	TArray<int32> QuerySubscriptions;
+
+	/** Subscriptions without any item filter. */
+	TArray<int32> UnfilteredSubscriptions;
+};
\ No newline at end of file
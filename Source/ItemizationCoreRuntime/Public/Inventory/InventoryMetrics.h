@@ -0,0 +1,115 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Counters of a single inventory over one metrics window. */
+struct FInventoryMetricsWindow
+{
+	/** Number of executed operations per op type name. */
+	TMap<const TCHAR*, uint32, TInlineSetAllocator<4>> OpsByType;
+
+	/** Total number of executed operations. */
+	uint32 NumOps = 0;
+
+	/** Number of item entries marked dirty for replication. */
+	uint32 NumDirtyMarks = 0;
+
+	/** Number of bits written when replicating the item list and item instances. */
+	uint64 NumReplicatedBits = 0;
+
+	/** Time spent giving items. */
+	double GiveSeconds = 0.0;
+
+	/** Time spent removing items. */
+	double RemoveSeconds = 0.0;
+
+	/** Returns the time spent giving and removing items. */
+	double GetTotalSeconds() const { return GiveSeconds + RemoveSeconds; }
+
+	void Reset();
+};
+
+/**
+ * Runtime cost metrics of a single inventory, so expensive inventories can be found on a live server.
+ * Counters are collected in windows of one second. The last complete window serves as the per second rates.
+ * Collection can be toggled at runtime with Itemization.Metrics.Enabled.
+ */
+struct ITEMIZATIONCORERUNTIME_API FInventoryMetrics
+{
+public:
+	/** Length of a single metrics window. */
+	static constexpr double WindowSeconds = 1.0;
+
+	/** Which time accumulator a scoped timer adds to. */
+	enum class ETimer : uint8
+	{
+		Give,
+		Remove,
+	};
+
+	/**
+	 * Adds the time spent in its scope to the inventory metrics. Nested timers of the same metrics only count once.
+	 * The outermost timer also counts as a give or remove op, unless it runs inside a queued op that has been counted already.
+	 */
+	class FScopedTimer
+	{
+	public:
+		FScopedTimer(FInventoryMetrics& InMetrics, ETimer InTimer);
+		~FScopedTimer();
+
+	private:
+		FInventoryMetrics& Metrics;
+		uint64 StartCycles = 0;
+		ETimer Timer;
+	};
+
+	/** Scope executing queued ops, which are counted by their own type. Gives and removes inside don't count as extra ops. */
+	class FScopedQueuedOps
+	{
+	public:
+		explicit FScopedQueuedOps(FInventoryMetrics& InMetrics);
+		~FScopedQueuedOps();
+
+	private:
+		FInventoryMetrics& Metrics;
+	};
+
+	/** Returns true if metrics are being collected. */
+	static bool IsEnabled();
+
+	void RecordOp(const TCHAR* OpTypeName);
+	void RecordDirtyMark();
+	void RecordReplicatedBits(int64 NumBits);
+	void RecordTime(ETimer Timer, double Seconds);
+
+	/** Returns the counters of the last complete window or an empty window if the inventory has been idle since. */
+	const FInventoryMetricsWindow& GetLastWindow() const;
+
+	/** Returns the time spent giving and removing items during the last frame. */
+	double GetLastFrameSeconds() const;
+
+	/** Returns the number of operations executed since the inventory has been created. */
+	uint64 GetTotalNumOps() const { return TotalNumOps; }
+
+private:
+	/** Moves on to the current window and frame. */
+	void Advance();
+
+	FInventoryMetricsWindow CurrentWindow;
+	FInventoryMetricsWindow LastWindow;
+	double CurrentWindowStart = 0.0;
+
+	uint64 CurrentFrame = 0;
+	double CurrentFrameSeconds = 0.0;
+	double LastFrameSeconds = 0.0;
+
+	uint64 TotalNumOps = 0;
+
+	/** Depth of running scoped timers, so nested gives and removes aren't counted twice. */
+	int32 TimerDepth = 0;
+
+	/** Depth of running queued op scopes. */
+	int32 QueuedOpDepth = 0;
+};
\ No newline at end of file
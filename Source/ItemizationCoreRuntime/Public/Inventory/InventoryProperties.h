@@ -39,9 +39,22 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Inventory)
 	int32 OverrideNumSlots = INDEX_NONE;
 
+	/**
+	 * Whether this inventory is an overflow inventory.
+	 * Routed items only end up here if no regular inventory has room, or if their traits force them into overflow.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Inventory)
+	bool bIsOverflow = false;
+
 	/** Item requirement query that specifies whether an item can be placed in this inventory. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Inventory)
 	FGameplayTagQuery ItemRequirementQuery;
+
+	/** Checks the item tags against the requirement query. An empty query accepts every item. */
+	bool AcceptsItem(const FGameplayTagContainer& ItemTags) const
+	{
+		return ItemRequirementQuery.IsEmpty() || ItemRequirementQuery.Matches(ItemTags);
+	}
 };
 
 USTRUCT(BlueprintType)
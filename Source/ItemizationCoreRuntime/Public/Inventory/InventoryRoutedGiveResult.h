@@ -0,0 +1,57 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemHandle.h"
+
+#include "InventoryRoutedGiveResult.generated.h"
+
+class AInventoryBase;
+
+/** Describes the part of a routed give that ended up in a single inventory. */
+USTRUCT(BlueprintType)
+struct FInventoryRoutedGiveEntry
+{
+	GENERATED_BODY()
+
+public:
+	/** The inventory the items have been given to. */
+	UPROPERTY(BlueprintReadOnly, Category=Inventory)
+	TWeakObjectPtr<AInventoryBase> Inventory;
+
+	/** Handle to the last item entry that received items in this inventory. */
+	UPROPERTY(BlueprintReadOnly, Category=Inventory)
+	FInventoryItemHandle ItemHandle;
+
+	/** Number of items given to this inventory. */
+	UPROPERTY(BlueprintReadOnly, Category=Inventory)
+	int32 Count = 0;
+};
+
+/** Combined result of giving an item across all inventories of an owner. */
+USTRUCT(BlueprintType)
+struct FInventoryRoutedGiveResult
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the number of items that have been given across all inventories. */
+	int32 GetTotalCount() const
+	{
+		int32 Total = 0;
+		for (const FInventoryRoutedGiveEntry& Entry : Entries)
+		{
+			Total += Entry.Count;
+		}
+		return Total;
+	}
+
+	/** Per inventory results, in the order the inventories have been filled. */
+	UPROPERTY(BlueprintReadOnly, Category=Inventory)
+	TArray<FInventoryRoutedGiveEntry> Entries;
+
+	/** Number of items that didn't fit into any inventory. */
+	UPROPERTY(BlueprintReadOnly, Category=Inventory)
+	int32 Excess = 0;
+};
\ No newline at end of file
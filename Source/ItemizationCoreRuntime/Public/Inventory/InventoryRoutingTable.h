@@ -0,0 +1,49 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UInventoryDefinition;
+class UItemDefinitionBase;
+
+/**
+ * Cached lookup table that maps item definitions to the inventories of a single inventory definition accepting them.
+ * Every item definition is evaluated against all item requirement queries exactly once, afterward routing is a map lookup.
+ * The table is invalidated whenever an inventory or item definition is reloaded or edited.
+ */
+struct ITEMIZATIONCORERUNTIME_API FInventoryRoutingTable
+{
+public:
+	/** Maximum number of inventories a single inventory definition can route to. */
+	static constexpr int32 MaxNumInventories = 64;
+
+	/**
+	 * Returns a bitmask of all inventories whose requirement query accepts the item.
+	 * Bit N maps to the inventory returned by UInventoryDefinition::GetInventoryProperties(N).
+	 */
+	uint64 GetAcceptingInventories(const UInventoryDefinition& InventoryDefinition, const UItemDefinitionBase* ItemDefinition);
+
+	/** Evaluates and caches the given item definitions up front, e.g. while loading. */
+	void Prewarm(const UInventoryDefinition& InventoryDefinition, TConstArrayView<const UItemDefinitionBase*> ItemDefinitions);
+
+	/** Drops all cached entries of this table. */
+	void Reset();
+
+	/** Invalidates every routing table, e.g. after an item definition has been changed. */
+	static void InvalidateAll();
+
+private:
+	/** Evaluates all requirement queries of the inventory definition for a single item. */
+	static uint64 EvaluateItem(const UInventoryDefinition& InventoryDefinition, const UItemDefinitionBase* ItemDefinition);
+
+	/** Resets the table if it has been built for an older generation. */
+	void ValidateGeneration();
+
+	/** Cached bitmask of accepting inventories per item definition. */
+	TMap<TObjectKey<UItemDefinitionBase>, uint64> AcceptingInventories;
+
+	/** The generation the cached entries have been evaluated for. */
+	uint32 Generation = 0;
+};
\ No newline at end of file
@@ -0,0 +1,48 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemHandle.h"
+#include "UObject/PrimaryAssetId.h"
+
+/** Hot fields of a single item entry, copied into an inventory snapshot. */
+struct FInventorySnapshotEntry
+{
+	/** Handle to the item entry. */
+	FInventoryItemHandle ItemHandle;
+
+	/** Primary asset id of the item definition. Safe to compare off the game thread, unlike the definition pointer. */
+	FPrimaryAssetId DefinitionId;
+
+	/** Stack count of the item entry at the time the snapshot was taken. */
+	int32 StackCount = 0;
+
+	/** Trait bits of the item definition. See FItemComponentData_Traits::GetTraitBit. */
+	uint64 TraitBits = 0;
+};
+
+/**
+ * Immutable copy of the hot fields of an inventory.
+ * Snapshots are never modified once published, so any thread can read them without locking.
+ */
+struct ITEMIZATIONCORERUNTIME_API FInventorySnapshot
+{
+	/** Returns the entry with the given handle or nullptr if it isn't part of this snapshot. */
+	const FInventorySnapshotEntry* FindEntry(const FInventoryItemHandle& ItemHandle) const;
+
+	/** Returns the summed up stack count of all entries of the given item definition. */
+	int32 GetTotalCount(const FPrimaryAssetId& DefinitionId) const;
+
+	/** Returns the summed up stack count of all entries having any of the given trait bits. See FItemComponentData_Traits::FindTraitBits. */
+	int32 GetTotalCountWithTraits(uint64 TraitBits) const;
+
+	/** Change log version of the inventory this snapshot was taken at. */
+	uint64 Version = 0;
+
+	/** Snapshot entries in the order of the inventory list. */
+	TArray<FInventorySnapshotEntry> Entries;
+};
+
+/** Shared, thread-safe reference to a published inventory snapshot. */
+using FInventorySnapshotPtr = TSharedPtr<const FInventorySnapshot, ESPMode::ThreadSafe>;
\ No newline at end of file
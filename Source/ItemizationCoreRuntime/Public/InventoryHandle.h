@@ -31,6 +31,12 @@ public:
 		return Inventory.Get();
 	}
 
+	/** Returns the unique identifier of this handle. */
+	const FGuid& GetGuid() const
+	{
+		return Guid;
+	}
+
 	/** Assigns a new inventory to this handle. */
 	FGuid AssignInventory(AInventoryBase* InInventory);
 
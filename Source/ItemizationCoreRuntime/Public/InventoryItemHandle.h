@@ -21,6 +21,17 @@ public:
 	/** Generates a new uid and sets it to this handle. */
 	void GenerateNewUID();
 
+	/** Restores a handle from a raw value that has been saved before. Call ReserveUIDs afterwards to avoid collisions. */
+	static FInventoryItemHandle FromRaw(uint32 InUID)
+	{
+		FInventoryItemHandle Handle;
+		Handle.UID = InUID;
+		return Handle;
+	}
+
+	/** Makes sure GenerateNewUID only returns values greater than the given one from now on. */
+	static void ReserveUIDs(uint32 MaxUsedUID);
+
 	/** Returns this handles raw value. */
 	uint32 Get() const
 	{
@@ -67,6 +78,12 @@ public:
 		return Ar;
 	}
 
+	/** Serializes the handle as a variable length integer. Small handle values only take a single byte. */
+	void SerializePacked(FArchive& Ar)
+	{
+		Ar.SerializeIntPacked(UID);
+	}
+
 	/** Returns a hash value for this handle. */
 	friend uint32 GetTypeHash(const FInventoryItemHandle& ItemHandle)
 	{
@@ -4,19 +4,60 @@
 
 #include "InventorySlotHandle.generated.h"
 
+/** Handle that points to a single slot inside an inventory slot group. Slots are addressed row-major. */
 USTRUCT(BlueprintType)
 struct alignas(8) FInventorySlotHandle
 {
 	GENERATED_BODY()
 
 	FInventorySlotHandle() = default;
+	FInventorySlotHandle(int32 InRowIndex, int32 InColumnIndex)
+		: RowIndex(InRowIndex)
+		, ColumnIndex(InColumnIndex)
+	{
+	}
 
 public:
+	/** Checks if this handle points to a slot. */
+	inline bool IsValid() const
+	{
+		return RowIndex != INDEX_NONE && ColumnIndex != INDEX_NONE;
+	}
+
+	/** Resets this handle to an invalid state. */
+	void Reset()
+	{
+		RowIndex = INDEX_NONE;
+		ColumnIndex = INDEX_NONE;
+	}
+
+	/** Converts this handle to a string. */
+	FString ToString() const
+	{
+		return IsValid() ? FString::Printf(TEXT("(%d|%d)"), RowIndex, ColumnIndex) : TEXT("NullSlot");
+	}
+
+	/** Compares this handle with another handle. */
+	bool operator==(const FInventorySlotHandle& Other) const
+	{
+		return RowIndex == Other.RowIndex && ColumnIndex == Other.ColumnIndex;
+	}
+	bool operator!=(const FInventorySlotHandle& Other) const
+	{
+		return !operator==(Other);
+	}
+
+	/** Returns a hash value for this handle. */
+	friend uint32 GetTypeHash(const FInventorySlotHandle& SlotHandle)
+	{
+		return HashCombine(::GetTypeHash(SlotHandle.RowIndex), ::GetTypeHash(SlotHandle.ColumnIndex));
+	}
+
 	UPROPERTY()
-	int32 RowIndex;
+	int32 RowIndex = INDEX_NONE;
 
 	UPROPERTY()
-	int32 ColumnIndex;
+	int32 ColumnIndex = INDEX_NONE;
 };
 
 static_assert(sizeof(FInventorySlotHandle) == sizeof(uint64), "Expected FInventorySlotHandle to be 8 bytes.");
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "UObject/Object.h"
+#include "Transactions/InventoryRequestLimiter.h"
 #include "ItemizationCoreSettings.generated.h"
 
 /** Configure the settings for the itemization core system. */
@@ -42,4 +43,49 @@ public:
 	/** Tag, that if present on an item, will prevent the item from being saved in the inventory. (For test or runtime items) */
 	UPROPERTY(Config, EditDefaultsOnly, Category=Traits, meta=(ConfigRestartRequired=true))
 	FGameplayTag TransientTag;
+
+	/**
+	 * Number of changes each inventory keeps in its versioned change log.
+	 * Consumers that fall further behind have to resync. Set to 0 to disable the change log.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Inventory, meta=(ClampMin=0, ConfigRestartRequired=true))
+	int32 ChangeLogCapacity;
+
+	/**
+	 * Number of records an inventory journal collects before it's compacted into a new snapshot.
+	 * Lower values keep recovery fast, higher values make saves cheaper. Set to 0 to never compact automatically.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Persistence, meta=(ClampMin=0))
+	int32 JournalCompactionThreshold;
+
+	/**
+	 * Seconds the persistence subsystem waits after an inventory got dirty before writing it.
+	 * All changes within the window are written with a single save.
+	 */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Persistence, meta=(ClampMin=0, Units="s"))
+	float SaveCoalescingWindow;
+
+	/** Maximum number of inventories handed to the storage provider with a single write. */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Persistence, meta=(ClampMin=1))
+	int32 MaxInventoriesPerWrite;
+
+	/** Token bucket that limits the requests of a single client connection, shared by all inventories of that connection. */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Requests)
+	FInventoryRequestBudget ConnectionRequestBudget;
+
+	/** Token bucket that limits the client requests to a single inventory. */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Requests)
+	FInventoryRequestBudget InventoryRequestBudget;
+
+	/** Budget cost of a single remove request. */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Requests, meta=(ClampMin=0))
+	float RemoveRequestCost;
+
+	/** Budget cost of a single move request. Moves touch two inventories and might run a merge scan on the target. */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Requests, meta=(ClampMin=0))
+	float MoveRequestCost;
+
+	/** Budget cost of a single place request. */
+	UPROPERTY(Config, EditDefaultsOnly, Category=Requests, meta=(ClampMin=0))
+	float PlaceRequestCost;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Logging/LogMacros.h"
+#include "Logging/StructuredLog.h"
 #include <concepts>
 #include <type_traits>
 #include <utility>
@@ -12,6 +13,24 @@ class UWorld;
 
 ITEMIZATIONCORERUNTIME_API DECLARE_LOG_CATEGORY_EXTERN(LogItemization, Log, All);
 
+/**
+ * Compile-time maximum verbosity of the item hot path category. More verbose messages are compiled out entirely.
+ * Defaults to All in development builds and Warning in test and shipping builds.
+ */
+#ifndef ITEMIZATION_ITEMS_COMPILED_VERBOSITY
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+#define ITEMIZATION_ITEMS_COMPILED_VERBOSITY Warning
+#else
+#define ITEMIZATION_ITEMS_COMPILED_VERBOSITY All
+#endif
+#endif
+
+/**
+ * Category of the per-item hot paths, e.g. giving, removing and creating instances.
+ * Only warnings are logged by default. Use "Log LogItemizationItems Verbose" to see every give and remove at runtime.
+ */
+ITEMIZATIONCORERUNTIME_API DECLARE_LOG_CATEGORY_EXTERN(LogItemizationItems, Warning, ITEMIZATION_ITEMS_COMPILED_VERBOSITY);
+
 namespace UE::ItemizationCore
 {
 	FString GetNetContextString(const UObject* Obj);
@@ -25,6 +44,15 @@ namespace UE::ItemizationCore
 #define ITEMIZATION_VERBOSE(Format, ...)			UE_LOG(LogItemization, Verbose, TEXT(Format), ##__VA_ARGS__)
 #define ITEMIZATION_VVERBOSE(Format, ...)			UE_LOG(LogItemization, VeryVerbose, TEXT(Format), ##__VA_ARGS__)
 
+/**
+ * Structured log on the item hot path category. Fields are named and only evaluated if the category is active at that verbosity.
+ * Example: ITEMIZATION_ITEM_LOGFMT(Verbose, "Giving item {Item}", ("Item", ItemHandle.ToString()));
+ */
+#define ITEMIZATION_ITEM_LOGFMT(Verbosity, Format, ...)	UE_LOGFMT(LogItemizationItems, Verbosity, Format, ##__VA_ARGS__)
+
+/** True if the item hot path category logs at the given verbosity. Guards log-only work that isn't part of a log statement. */
+#define ITEMIZATION_ITEM_LOG_ACTIVE(Verbosity)			UE_LOG_ACTIVE(LogItemizationItems, Verbosity)
+
 #define EXEC_INFO_FORMAT "%s: "
 #define EXEC_INFO *FString(__FUNCTION__)
 
@@ -0,0 +1,50 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+/** Whether the itemization trace channel, stat scopes and counters are compiled in. Always off in shipping builds. */
+#ifndef ITEMIZATION_WITH_STATS
+#define ITEMIZATION_WITH_STATS !UE_BUILD_SHIPPING
+#endif
+
+#if ITEMIZATION_WITH_STATS
+
+UE_TRACE_CHANNEL_EXTERN(ItemizationChannel, ITEMIZATIONCORERUNTIME_API);
+
+DECLARE_STATS_GROUP(TEXT("Itemization"), STATGROUP_Itemization, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GiveItem"), STAT_Itemization_GiveItem, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("NativeGiveItem"), STAT_Itemization_NativeGiveItem, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("NativeRemoveItem"), STAT_Itemization_NativeRemoveItem, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EvaluateItemEntry"), STAT_Itemization_EvaluateItemEntry, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CreateNewInstanceOfItem"), STAT_Itemization_CreateNewInstanceOfItem, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ReplicateSubobjects"), STAT_Itemization_ReplicateSubobjects, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnRep_InventoryList"), STAT_Itemization_OnRepInventoryList, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ExecutePendingOperations"), STAT_Itemization_ExecutePendingOperations, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Item Entries"), STAT_Itemization_NumEntries, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Item Instances"), STAT_Itemization_NumInstances, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Operations per Frame"), STAT_Itemization_NumOperations, STATGROUP_Itemization, ITEMIZATIONCORERUNTIME_API);
+
+/** Times the enclosing scope as STAT_Itemization_<Name> and as a CPU event on the Itemization trace channel. */
+#define ITEMIZATION_SCOPE_CYCLE_COUNTER(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("Itemization::" #Name, ItemizationChannel); \
+	SCOPE_CYCLE_COUNTER(STAT_Itemization_##Name)
+
+#define ITEMIZATION_INC_STAT_BY(Name, Amount)		INC_DWORD_STAT_BY(STAT_Itemization_##Name, Amount)
+#define ITEMIZATION_DEC_STAT_BY(Name, Amount)		DEC_DWORD_STAT_BY(STAT_Itemization_##Name, Amount)
+
+#else
+
+#define ITEMIZATION_SCOPE_CYCLE_COUNTER(Name)
+#define ITEMIZATION_INC_STAT_BY(Name, Amount)
+#define ITEMIZATION_DEC_STAT_BY(Name, Amount)
+
+#endif
+
+#define ITEMIZATION_INC_STAT(Name)					ITEMIZATION_INC_STAT_BY(Name, 1)
+#define ITEMIZATION_DEC_STAT(Name)					ITEMIZATION_DEC_STAT_BY(Name, 1)
\ No newline at end of file
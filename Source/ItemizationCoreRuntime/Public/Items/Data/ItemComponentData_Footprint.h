@@ -0,0 +1,36 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "ItemComponentData.h"
+#include "Items/InventoryItemSlot.h"
+
+#include "ItemComponentData_Footprint.generated.h"
+
+class UItemDefinitionBase;
+
+/**
+ * Item data for defining how many cells an item occupies in an inventory slot group.
+ * Without this item data, the item is assumed to occupy a single cell.
+ */
+USTRUCT(DisplayName="Footprint Item Data")
+struct FItemComponentData_Footprint : public FItemComponentData
+{
+	GENERATED_BODY()
+
+public:
+	FItemComponentData_Footprint();
+	static FInventorySlotFootprint GetFootprint(const UItemDefinitionBase* InItemDefinition);
+
+public:
+	/** The cells this item occupies in a slot group. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Footprint, meta=(ShowOnlyInnerProperties))
+	FInventorySlotFootprint Footprint;
+
+protected:
+	//~ Begin FItemComponentData Interface
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+	//~ End FItemComponentData Interface
+};
\ No newline at end of file
@@ -20,6 +20,33 @@ public:
 	FItemComponentData_Traits();
 	static bool HasTrait(const UItemDefinitionBase* InItemDefinition, const FGameplayTag& TraitToCheck);
 
+	/** Returns all traits of the item definition. Returns an empty container if it has no traits data. */
+	static const FGameplayTagContainer& GetTraits(const UItemDefinitionBase* InItemDefinition);
+
+	/** Maximum number of distinct traits that can be represented as trait bits. */
+	static constexpr int32 MaxNumTraitBits = 64;
+
+	/**
+	 * Returns the bit assigned to the given trait, assigning a new one on first use.
+	 * Returns 0 if the trait is invalid or all bits are taken.
+	 */
+	static uint64 GetTraitBit(const FGameplayTag& Trait);
+
+	/** Returns the combined bits of the given traits, assigning new bits to unknown traits. */
+	static uint64 MakeTraitBits(const FGameplayTagContainer& InTraits);
+
+	/** Returns the combined bits of the given traits that already have a bit assigned. Never assigns new bits. Can be called from any thread. */
+	static uint64 FindTraitBits(const FGameplayTagContainer& InTraits);
+
+	/** Returns the bits of all traits of the item definition that have a bit assigned. Can be called from any thread. */
+	static uint64 GetTraitBits(const UItemDefinitionBase* InItemDefinition);
+
+	/** Assigns bits to all traits of the item definition. Called when a definition is loaded, so trait bits exist before anyone queries them. */
+	static void RegisterTraitBits(const UItemDefinitionBase* InItemDefinition);
+
+	/** Event broadcast on the game thread after a new trait bit has been assigned. Trait bits computed before are incomplete. */
+	static FSimpleMulticastDelegate& OnTraitBitAdded();
+
 public:
 	/** Traits that this item has. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Traits, meta=(Categories="Item.Trait"))
@@ -43,6 +43,9 @@ public:
 	void SetReplicatedItemInstance(UInventoryItemInstance* InInstance);
 	void SetNonReplicatedItemInstance(UInventoryItemInstance* InInstance);
 
+	/** Forgets the item instance without touching it, e.g. after it has been handed over to another entry. */
+	void ClearItemInstance();
+
 	/** Returns a stat integer associated with the given tag. */
 	int32 GetStatValue(const FGameplayTag& Tag) const;
 
@@ -162,10 +165,7 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
 	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
 
-	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
-	{
-		return FFastArraySerializer::FastArrayDeltaSerialize<FInventoryItemEntry, FInventoryItemContainer>(Items, DeltaParms, *this);
-	}
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
 
 	template <typename  Type, typename SerializerType>
 	bool ShouldWriteFastArrayItem(const Type& Item, const bool bIsWritingOnClient)
@@ -10,6 +10,8 @@
 
 #include "InventoryItemSlot.generated.h"
 
+struct FInventoryGroupConfig;
+
 /** Fast array serializer item for a single item slot in an inventory. */
 USTRUCT(BlueprintType)
 struct FInventoryItemSlot : public FFastArraySerializerItem
@@ -31,17 +33,198 @@ public:
 	FInventoryItemHandle ItemHandle;
 };
 
+/** Describes the number of cells an item occupies in a slot group. */
+USTRUCT(BlueprintType)
+struct FInventorySlotFootprint
+{
+	GENERATED_BODY()
+
+	FInventorySlotFootprint() = default;
+	FInventorySlotFootprint(int32 InWidth, int32 InHeight, bool bInCanRotate = false)
+		: Width(InWidth)
+		, Height(InHeight)
+		, bCanRotate(bInCanRotate)
+	{
+	}
+
+public:
+	/** Returns this footprint rotated by 90 degrees. */
+	FInventorySlotFootprint GetRotated() const
+	{
+		return FInventorySlotFootprint(Height, Width, bCanRotate);
+	}
+
+	/** Returns the number of cells this footprint occupies. */
+	int32 GetArea() const { return Width * Height; }
+
+	/** Number of columns the item occupies. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Footprint, meta=(ClampMin=1, UIMin=1, ClampMax=64, UIMax=64))
+	int32 Width = 1;
+
+	/** Number of rows the item occupies. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Footprint, meta=(ClampMin=1, UIMin=1))
+	int32 Height = 1;
+
+	/** Whether the item may be rotated by 90 degrees to make it fit. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Footprint)
+	bool bCanRotate = false;
+};
+
+/** Describes where an item has been placed inside a slot group. */
+USTRUCT()
+struct FInventorySlotPlacement
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the footprint as it is placed, respecting rotation. */
+	FInventorySlotFootprint GetPlacedFootprint() const
+	{
+		return bRotated ? Footprint.GetRotated() : Footprint;
+	}
+
+	/** The item that has been placed. */
+	UPROPERTY()
+	FInventoryItemHandle ItemHandle;
+
+	/** The top-left slot of the placement. */
+	UPROPERTY()
+	FInventorySlotHandle Origin;
+
+	/** The unrotated footprint of the item. */
+	UPROPERTY()
+	FInventorySlotFootprint Footprint;
+
+	/** Whether the item has been placed rotated. */
+	UPROPERTY()
+	bool bRotated = false;
+};
+
+/**
+ * A group of item slots laid out as a grid.
+ * Next to the slot list, the group keeps a row-major occupancy bitmap where every row is a single 64-bit word.
+ * Free slot queries are word-level bit scans instead of walking the slot list.
+ */
 USTRUCT()
 struct FInventoryItemSlotGroup
 {
 	GENERATED_BODY()
 
+public:
+	/** Maximum number of columns per group, as every row is stored as a single occupancy word. */
+	static constexpr int32 MaxNumColumns = 64;
+
+	/** Creates the slot list and the occupancy bitmap from the given group config. */
+	void Initialize(const FInventoryGroupConfig& Config);
+
+	/** Returns true if the slot handle points inside this group. */
+	bool IsValidSlot(const FInventorySlotHandle& SlotHandle) const;
+
+	/** Returns true if the slot is inside this group and not occupied. */
+	bool IsSlotFree(const FInventorySlotHandle& SlotHandle) const;
+
+	/** Returns the number of slots that are not occupied. */
+	int32 GetNumFreeSlots() const { return NumFreeSlots; }
+
+	/** Returns true if at least NumSlots slots are not occupied. */
+	bool HasRoom(int32 NumSlots = 1) const { return NumFreeSlots >= NumSlots; }
+
+	/** Finds the first free slot in row-major order. */
+	bool FindFirstFreeSlot(FInventorySlotHandle& OutSlotHandle) const;
+
+	/** Finds the first run of Length consecutive free slots within a single row. */
+	bool FindFreeRun(int32 Length, FInventorySlotHandle& OutSlotHandle) const;
+
+	/** Marks the slot occupied by the given item. Returns false if the slot is invalid or already occupied. */
+	bool OccupySlot(const FInventorySlotHandle& SlotHandle, const FInventoryItemHandle& ItemHandle);
+
+	/** Frees the slot and every other slot of the item placed in it. Returns false if the slot wasn't occupied. */
+	bool ReleaseSlot(const FInventorySlotHandle& SlotHandle);
+
+	/** Returns true if the footprint fits with its top-left corner at Origin. */
+	bool CanPlaceFootprint(const FInventorySlotHandle& Origin, const FInventorySlotFootprint& Footprint) const;
+
+	/**
+	 * Finds the first origin in row-major order where the footprint fits.
+	 * Rotation is only tried if the unrotated footprint doesn't fit anywhere and the footprint allows it.
+	 */
+	bool FindFitForFootprint(const FInventorySlotFootprint& Footprint, FInventorySlotHandle& OutOrigin, bool& bOutRotated) const;
+
+	/** Places the item with its top-left corner at Origin. Returns false if any of the covered slots is taken. */
+	bool PlaceItem(const FInventoryItemHandle& ItemHandle, const FInventorySlotHandle& Origin, const FInventorySlotFootprint& Footprint, bool bRotated = false);
+
+	/** Finds a fit for the footprint and places the item there. */
+	bool PlaceItemAnywhere(const FInventoryItemHandle& ItemHandle, const FInventorySlotFootprint& Footprint, FInventorySlotHandle* OutOrigin = nullptr);
+
+	/** Removes the item and frees all slots it covered. */
+	bool RemoveItem(const FInventoryItemHandle& ItemHandle);
+
+	/** Rotates the item in place around its origin. Returns false if it can't rotate or wouldn't fit. */
+	bool RotateItem(const FInventoryItemHandle& ItemHandle);
+
+	/**
+	 * Re-arranges all placed items to compact the group, placing larger footprints first.
+	 * The previous layout is kept if the items couldn't all be placed again.
+	 */
+	bool AutoPack();
+
+	/** Returns the placement of the given item or nullptr if it isn't placed in this group. */
+	const FInventorySlotPlacement* FindPlacement(const FInventoryItemHandle& ItemHandle) const;
+
+	/** Returns the slot the handle points to. */
+	const FInventoryItemSlot* FindSlot(const FInventorySlotHandle& SlotHandle) const;
+
+	/** Converts a slot handle into an index into the slot list. */
+	int32 GetSlotIndex(const FInventorySlotHandle& SlotHandle) const
+	{
+		return IsValidSlot(SlotHandle) ? SlotHandle.RowIndex * NumColumns + SlotHandle.ColumnIndex : INDEX_NONE;
+	}
+
+	/** Returns the occupancy word of the given row. A set bit means the column is occupied. */
+	uint64 GetRowOccupancy(int32 RowIndex) const { return RowOccupancy[RowIndex]; }
+
+	/** Returns the mask of all valid columns in a row. */
+	uint64 GetColumnMask() const { return ColumnMask; }
+
 public:
 	UPROPERTY()
 	FGameplayTag GroupTag;
 
+	UPROPERTY()
+	int32 NumRows = 0;
+
+	UPROPERTY()
+	int32 NumColumns = 0;
+
+	/** Row-major list of all slots in this group. */
 	UPROPERTY()
 	TArray<FInventoryItemSlot> SlotList;
+
+	/** All items placed in this group. */
+	UPROPERTY()
+	TArray<FInventorySlotPlacement> Placements;
+
+protected:
+	/** Finds the first origin for the exact footprint without trying any rotation. */
+	bool FindFitForSize(int32 Width, int32 Height, FInventorySlotHandle& OutOrigin) const;
+
+	/** Writes the item handle into all covered slots and updates the occupancy words. */
+	void SetPlacementOccupied(const FInventorySlotPlacement& Placement, bool bOccupied);
+
+	/** Updates the occupancy bits of the given columns in a single row and keeps the summary words in sync. */
+	void SetRowOccupied(int32 RowIndex, uint64 ColumnBits, bool bOccupied);
+
+	/** One word per row. A set bit means the column is occupied. */
+	TArray<uint64> RowOccupancy;
+
+	/** One bit per row. A set bit means the row still has at least one free slot. */
+	TArray<uint64> RowsWithRoom;
+
+	/** Mask of all valid columns in a row. */
+	uint64 ColumnMask = 0;
+
+	/** Cached number of free slots. */
+	int32 NumFreeSlots = 0;
 };
 
 /** Fast array serializer for a list of item slots in an inventory. */
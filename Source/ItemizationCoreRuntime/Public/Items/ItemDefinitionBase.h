@@ -52,6 +52,13 @@ public:
 	}
 
 protected:
+	//~ Begin UObject Interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~ End UObject Interface
+
 	/** List of item components that are attached to this item. */
 	UPROPERTY(EditDefaultsOnly, Category=Item, NoClear, meta=(ExcludeBaseStruct,ShowOnlyInnerProperties))
 	TArray<FItemComponentDataInstance> DataList;
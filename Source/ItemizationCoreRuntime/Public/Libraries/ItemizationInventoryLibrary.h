@@ -4,10 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "InventoryItemHandle.h"
+#include "Inventory/InventoryRoutedGiveResult.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "ItemizationInventoryLibrary.generated.h"
 
 struct FInventoryTrackableOp;
+class AInventoryBase;
+class UActorComponent;
+class UInventoryDefinition;
 class UItemDefinitionBase;
 class IInventoryOwnerInterface;
 /**
@@ -22,6 +26,65 @@ public:
 	UFUNCTION(BlueprintCallable)
 	static FInventoryItemHandle GiveItem(TScriptInterface<IInventoryOwnerInterface> InventoryOwner, UItemDefinitionBase* ItemDefinition, int32 StackCount, int32& ExcessAmount);
 
+	/**
+	 * Gives an item to the inventory owner, routing it across all inventories described by the inventory definition.
+	 * Targets are picked by their item requirement queries, their remaining capacity and the overflow traits of the item.
+	 * Inventories that already hold the item are filled first. Whatever doesn't fit spills over into the next one.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Itemization)
+	static FInventoryRoutedGiveResult GiveItemRouted(
+		AActor* InventoryOwner,
+		const UInventoryDefinition* InventoryDefinition,
+		UItemDefinitionBase* ItemDefinition,
+		int32 StackCount);
+
+	/**
+	 * Resolves the inventories of the owner for every routing index of the inventory definition.
+	 * Entries are nullptr if the owner has no matching inventory component.
+	 */
+	static void FindRoutedInventories(
+		const AActor* InventoryOwner,
+		const UInventoryDefinition* InventoryDefinition,
+		TArray<AInventoryBase*, TInlineAllocator<8>>& OutInventories);
+
+	/**
+	 * Resolves the inventory components of the owner for every routing index of the inventory definition.
+	 * Each component backs a single inventory. Multiple inventories of the same component class are mapped in order.
+	 */
+	static void FindRoutedComponents(
+		const AActor* InventoryOwner,
+		const UInventoryDefinition* InventoryDefinition,
+		TArray<UActorComponent*, TInlineAllocator<8>>& OutComponents);
+
+	/** Binds every inventory component of the owner to its entry of the inventory definition, e.g. to apply its slot limit. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Itemization)
+	static void ApplyInventoryDefinition(AActor* InventoryOwner, const UInventoryDefinition* InventoryDefinition);
+
+	/** Queues a give item operation on the inventory and continues once it has been executed. Fails on the next tick if the inventory is invalid. */
+	UFUNCTION(BlueprintCallable, Category=Itemization, meta=(Latent, LatentInfo="LatentInfo", WorldContext="WorldContextObject"))
+	static void GiveItemAndWait(
+		UObject* WorldContextObject,
+		FLatentActionInfo LatentInfo,
+		AInventoryBase* Inventory,
+		UItemDefinitionBase* ItemDefinition,
+		int32 StackCount,
+		FInventoryItemHandle& ItemHandle,
+		int32& Excess,
+		bool& bSuccess);
+
+	/** Queues a move item operation between two inventories and continues once it has been executed. Fails on the next tick if either inventory is invalid. */
+	UFUNCTION(BlueprintCallable, Category=Itemization, meta=(Latent, LatentInfo="LatentInfo", WorldContext="WorldContextObject"))
+	static void MoveItemAndWait(
+		UObject* WorldContextObject,
+		FLatentActionInfo LatentInfo,
+		AInventoryBase* SourceInventory,
+		AInventoryBase* TargetInventory,
+		FInventoryItemHandle ItemHandle,
+		int32 Delta,
+		FInventoryItemHandle& TargetItemHandle,
+		int32& Excess,
+		bool& bSuccess);
+
 	/** Performs a transaction on the inventory. */
 	UFUNCTION(BlueprintCallable, Category=Itemization)
 	static void PerformTransaction(
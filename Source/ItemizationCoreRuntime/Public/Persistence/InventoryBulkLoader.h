@@ -0,0 +1,82 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Persistence/InventorySaveData.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Restores many inventories at once from a single packed file, e.g. when a server starts or takes over a shard.
+ * The file is memory mapped and entries are decoded straight from the mapped pages, without reading it into memory first.
+ *
+ * Layout:
+ *	- Header:		Magic, pack version, number of inventories
+ *	- Index:		Key, offset and size of every inventory
+ *	- Inventories:	Uncompressed saves as written by FInventorySerializer::Encode
+ */
+class ITEMIZATIONCORERUNTIME_API FInventoryBulkLoader
+{
+public:
+	/** Magic number at the start of every packed file. */
+	static constexpr uint32 PackMagic = 0x5A4D5450;
+
+	/** Version of the packed file layout. */
+	static constexpr uint16 PackVersion = 1;
+
+	/** @param bDeferInstances	Whether item instances are created later by CreateDeferredInstances instead of during restore. */
+	explicit FInventoryBulkLoader(bool bDeferInstances = true);
+	~FInventoryBulkLoader();
+
+	/** Captures the given inventories and writes them into a single packed file. Game thread only. */
+	static bool WritePackedFile(const FString& FilePath, TConstArrayView<TPair<FString, const AInventoryBase*>> Inventories);
+
+	/** Maps the packed file and reads its index. */
+	bool Open(const FString& FilePath);
+
+	/** Unmaps the packed file. Deferred instances stay queued, they don't reference the file anymore. */
+	void Close();
+
+	/** Returns true if the inventory with the given key is in the packed file. */
+	bool Contains(const FString& Key) const { return Index.Contains(Key); }
+
+	/** Returns the number of inventories in the packed file. */
+	int32 Num() const { return Index.Num(); }
+
+	/** Restores an empty inventory from the packed file. Game thread only. */
+	bool Restore(const FString& Key, AInventoryBase& Inventory);
+
+	/**
+	 * Restores all inventories of the packed file. Game thread only.
+	 * @param ResolveInventory	Returns the empty inventory to restore the given key into or nullptr to skip it.
+	 * @return The number of restored inventories.
+	 */
+	int32 RestoreAll(TFunctionRef<AInventoryBase*(const FString& Key)> ResolveInventory);
+
+	/**
+	 * Creates item instances whose creation has been deferred. Meant to be called once per frame until all have been created.
+	 * @param MaxSeconds	Time budget of this call. Values <= 0 create all remaining instances.
+	 */
+	int32 CreateDeferredInstances(double MaxSeconds);
+
+	/** Returns true if there are item instances left to create. */
+	bool HasDeferredInstances() const { return LoadContext.HasDeferredInstances(); }
+
+private:
+	struct FIndexEntry
+	{
+		uint64 Offset = 0;
+		uint32 Size = 0;
+	};
+
+	/** Location of every inventory inside the mapped file. */
+	TMap<FString, FIndexEntry> Index;
+
+	/** State shared by all restores, so definitions are only resolved once. */
+	FInventoryLoadContext LoadContext;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+};
@@ -0,0 +1,46 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class AInventoryBase;
+struct FInventoryItemSlotGroup;
+
+/** Sections of a handoff. Importers skip sections they don't know, so new ones can be added without a version bump. */
+enum class EInventoryHandoffSection : uint8
+{
+	/** The item entries with their handles, stats, slot numbers and all non-transient instance properties, encoded by FInventorySerializer. */
+	Inventory = 1,
+
+	/** Placements of all items inside the slot groups of the inventory. */
+	SlotGroups = 2,
+};
+
+/**
+ * Self-describing export of a whole inventory, used to move it to another server process, e.g. on a shard transfer.
+ * Unlike a save, the handoff also carries transient items and the slot group layout, and restores the exact same handles.
+ *
+ * Layout:
+ *	- Header:		Magic, handoff version
+ *	- Sections:		Section id, size and payload, repeated until the end
+ */
+class ITEMIZATIONCORERUNTIME_API FInventoryHandoff
+{
+public:
+	/** Magic number at the start of every handoff. */
+	static constexpr uint32 Magic = 0x5A4D5448;
+
+	/** Version of the handoff container. */
+	static constexpr uint16 Version = 1;
+
+	/** Exports the inventory and the layout of the given slot groups. Game thread only. */
+	static void Export(const AInventoryBase& Inventory, TConstArrayView<const FInventoryItemSlotGroup*> SlotGroups, TArray<uint8>& OutBytes);
+
+	/**
+	 * Recreates an exported inventory on a fresh, empty inventory. Game thread only.
+	 * @param FindSlotGroup		Returns the initialized slot group of the target for the given group tag, or nullptr if it has none.
+	 */
+	static bool Import(AInventoryBase& Inventory, TConstArrayView<uint8> Bytes, TFunctionRef<FInventoryItemSlotGroup*(const FGameplayTag&)> FindSlotGroup);
+};
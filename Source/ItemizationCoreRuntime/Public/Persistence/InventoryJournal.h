@@ -0,0 +1,93 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Enums/EInventoryChangeKind.h"
+
+class AInventoryBase;
+struct FInventoryItemEntry;
+
+/** Storage of an inventory journal: the last full snapshot plus the records appended since. */
+class IInventoryJournalBackend
+{
+public:
+	virtual ~IInventoryJournalBackend() {}
+
+	/** Appends a block of encoded records to the journal tail. */
+	virtual bool Append(TConstArrayView<uint8> Block) = 0;
+
+	/** Reads the whole journal tail written since the last snapshot. */
+	virtual bool ReadTail(TArray<uint8>& OutTail) = 0;
+
+	/** Replaces the snapshot and truncates the journal tail. */
+	virtual bool WriteSnapshot(TConstArrayView<uint8> Snapshot) = 0;
+
+	/** Reads the last snapshot. Returns false if there is none. */
+	virtual bool ReadSnapshot(TArray<uint8>& OutSnapshot) = 0;
+};
+
+/** Journal backend storing the snapshot and the tail as two files next to each other. */
+class ITEMIZATIONCORERUNTIME_API FInventoryFileJournalBackend : public IInventoryJournalBackend
+{
+public:
+	/** Creates a backend writing <BasePath>.snap and <BasePath>.wal */
+	explicit FInventoryFileJournalBackend(const FString& InBasePath);
+
+	//~ Begin IInventoryJournalBackend Interface
+	virtual bool Append(TConstArrayView<uint8> Block) override;
+	virtual bool ReadTail(TArray<uint8>& OutTail) override;
+	virtual bool WriteSnapshot(TConstArrayView<uint8> Snapshot) override;
+	virtual bool ReadSnapshot(TArray<uint8>& OutSnapshot) override;
+	//~ End IInventoryJournalBackend Interface
+
+private:
+	FString SnapshotPath;
+	FString TailPath;
+};
+
+/**
+ * Append-only write-ahead journal of item changes for a single inventory.
+ * Every change of an item entry is encoded as a small record right away and written as one block on Flush,
+ * so a save costs O(changes) instead of rewriting the whole inventory. Once enough records piled up,
+ * the journal is compacted into a new full snapshot. After a crash, Recover loads the snapshot and replays the tail.
+ */
+class ITEMIZATIONCORERUNTIME_API FInventoryJournal
+{
+public:
+	explicit FInventoryJournal(TUniquePtr<IInventoryJournalBackend>&& InBackend);
+
+	/** Encodes the current state of an item entry after it changed. Called from the mutation paths of the inventory. */
+	void RecordChange(const FInventoryItemEntry& ItemEntry, EInventoryChangeKind Kind);
+
+	/** Writes all pending records to the backend and compacts the journal if it grew too large. Game thread only. */
+	bool Flush(const AInventoryBase& Inventory);
+
+	/** Writes a new full snapshot of the inventory and truncates the journal tail. Game thread only. */
+	bool Compact(const AInventoryBase& Inventory);
+
+	/** Restores an empty inventory from the last snapshot and replays the journal tail on top. Writes the first snapshot if none exists yet. Game thread only. */
+	bool Recover(AInventoryBase& Inventory);
+
+	/** Returns true if there are records that haven't been flushed yet. */
+	bool HasPendingRecords() const { return !PendingRecords.IsEmpty(); }
+
+	/** Returns the number of records written since the last snapshot. */
+	int32 GetNumRecordsSinceSnapshot() const { return NumRecordsSinceSnapshot; }
+
+private:
+	/** Applies a tail of encoded record blocks to the inventory. Stops at the first torn or corrupted block. */
+	int32 ReplayTail(AInventoryBase& Inventory, TConstArrayView<uint8> Tail) const;
+
+	/** Storage of the snapshot and tail. */
+	TUniquePtr<IInventoryJournalBackend> Backend;
+
+	/** Encoded records that haven't been flushed yet. */
+	TArray<uint8> PendingRecords;
+
+	/** Number of records in PendingRecords. */
+	int32 NumPendingRecords = 0;
+
+	/** Number of records written since the last snapshot, including pending ones. */
+	int32 NumRecordsSinceSnapshot = 0;
+};
\ No newline at end of file
@@ -0,0 +1,113 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "InventoryPersistenceSubsystem.generated.h"
+
+class AInventoryBase;
+class IInventoryStorageProvider;
+struct FInventoryChangeSet;
+
+/** Called on the game thread once an inventory has been loaded from storage. */
+using FInventoryStorageLoadCompleted = TUniqueFunction<void(bool bSuccess)>;
+
+/**
+ * Keeps registered inventories saved in a storage provider.
+ * Changes only mark an inventory as dirty. Dirty inventories are written together once the save window has passed,
+ * so the write volume scales with the number of distinct dirty inventories rather than with the number of changes.
+ * Uses a local file provider in Saved/Inventories until another provider is set.
+ */
+UCLASS(MinimalAPI)
+class UInventoryPersistenceSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the persistence subsystem of the game instance of the given object. */
+	ITEMIZATIONCORERUNTIME_API static UInventoryPersistenceSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/** Replaces the storage provider. Pending writes of the previous provider are finished first. */
+	ITEMIZATIONCORERUNTIME_API void SetStorageProvider(TSharedRef<IInventoryStorageProvider> InStorageProvider);
+
+	/** Returns the storage provider inventories are saved to. */
+	IInventoryStorageProvider& GetStorageProvider() const { return *StorageProvider; }
+
+	/** Starts saving the inventory under the given key whenever it changes. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	ITEMIZATIONCORERUNTIME_API void RegisterInventory(AInventoryBase* Inventory, const FString& Key);
+
+	/** Stops saving the inventory. Pending changes are written right away. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	ITEMIZATIONCORERUNTIME_API void UnregisterInventory(AInventoryBase* Inventory);
+
+	/** Marks a registered inventory as dirty, so it's written with the next batch. */
+	ITEMIZATIONCORERUNTIME_API void MarkDirty(AInventoryBase* Inventory);
+
+	/** Writes all dirty inventories right away instead of waiting for the save window. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Inventory)
+	ITEMIZATIONCORERUNTIME_API void FlushDirtyInventories();
+
+	/** Restores an empty inventory from the storage. The read is queued behind all pending writes, so it observes every save issued before. */
+	ITEMIZATIONCORERUNTIME_API void LoadInventory(AInventoryBase* Inventory, const FString& Key, FInventoryStorageLoadCompleted&& OnCompleted);
+
+	/** Returns how often registered inventories have been marked dirty. */
+	uint64 GetNumDirtyMarks() const { return NumDirtyMarks; }
+
+	/** Returns how many inventories have been handed to the storage provider. */
+	uint64 GetNumWrittenInventories() const { return NumWrittenInventories; }
+
+private:
+	struct FRegisteredInventory
+	{
+		/** Key of the inventory within the storage. */
+		FString Key;
+
+		/** Handle of the change set listener. */
+		FDelegateHandle ChangeSetHandle;
+
+		/** Whether the inventory changed since it was last written. */
+		bool bDirty = false;
+	};
+
+	/** Checks whether the save window of the oldest dirty inventory has passed. */
+	bool Tick(float DeltaTime);
+
+	/** Marks the inventory of a change set as dirty. */
+	void HandleChangeSet(const FInventoryChangeSet& ChangeSet);
+
+	/** Captures the given dirty inventories and writes them in batches. */
+	void WriteInventories(TArrayView<const TWeakObjectPtr<AInventoryBase>> Inventories);
+
+	/** Marks all inventories whose write failed as dirty again. */
+	void HandleWriteFailed(TArray<FString>&& FailedKeys);
+
+	/** Storage all inventories are saved to. */
+	TSharedPtr<IInventoryStorageProvider> StorageProvider;
+
+	/** All inventories that are kept saved. */
+	TMap<TWeakObjectPtr<AInventoryBase>, FRegisteredInventory> RegisteredInventories;
+
+	/** Number of registered inventories that are dirty. */
+	int32 NumDirtyInventories = 0;
+
+	/** Time the first inventory got dirty since the last write. */
+	double FirstDirtyTime = 0.0;
+
+	/** The last launched encoding or read task. Every task waits for the one before, so batches reach the provider in order. */
+	UE::Tasks::FTask LastEncode;
+
+	/** Ticker checking for dirty inventories. */
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	uint64 NumDirtyMarks = 0;
+	uint64 NumWrittenInventories = 0;
+};
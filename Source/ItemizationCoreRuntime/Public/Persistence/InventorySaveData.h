@@ -0,0 +1,170 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "InventoryItemHandle.h"
+#include "Tasks/Task.h"
+#include "UObject/PrimaryAssetId.h"
+
+class AInventoryBase;
+class UItemDefinitionBase;
+
+/** Versions of the binary inventory save format. New versions must only ever be appended. */
+enum class EInventorySaveVersion : uint16
+{
+	Initial = 1,
+
+	// -----<new versions can be added above this line>-----
+	VersionPlusOne,
+	Latest = VersionPlusOne - 1
+};
+
+/** A single item entry captured for saving. */
+struct FInventorySaveEntry
+{
+	/** Raw value of the item handle. Handles are kept across save and load. */
+	uint32 ItemHandle = 0;
+
+	/** Index into the definition table of the save data. */
+	int32 DefinitionIndex = INDEX_NONE;
+
+	/** Slot number of the item entry. */
+	uint32 SlotNumber = INDEX_NONE;
+
+	/** One bit per stat slot of the save data. StatValues holds a value for each set bit, lowest bit first. */
+	uint64 StatMask = 0;
+
+	/** Values of the stats present in StatMask. */
+	TArray<int32, TInlineAllocator<4>> StatValues;
+
+	/** SaveGame properties of the item instance. Empty if the entry has no instance. */
+	TArray<uint8> InstancePayload;
+};
+
+/**
+ * Plain data copy of the persistent entries of an inventory.
+ * Doesn't reference any UObjects, so it can be encoded on any thread once captured.
+ */
+struct ITEMIZATIONCORERUNTIME_API FInventorySaveData
+{
+	/** Maximum number of distinct stats a single save can hold. */
+	static constexpr int32 MaxNumStatSlots = 64;
+
+	/** Stable ids of all item definitions referenced by the entries. */
+	TArray<FPrimaryAssetId> Definitions;
+
+	/** Stat tags, each owning a fixed slot in the stat masks of the entries. */
+	TArray<FGameplayTag> StatTags;
+
+	/** The captured item entries. */
+	TArray<FInventorySaveEntry> Entries;
+
+	/** Maximum number of stacks that count towards the inventory limit. */
+	int32 MaxNumSlots = INDEX_NONE;
+
+	/** Resets the save data, keeping the allocations. */
+	void Reset();
+};
+
+/** An item instance whose creation has been deferred while loading. */
+struct FInventoryDeferredInstance
+{
+	/** The inventory the entry has been loaded into. */
+	TWeakObjectPtr<AInventoryBase> Inventory;
+
+	/** Handle of the entry that wants an instance. */
+	FInventoryItemHandle ItemHandle;
+
+	/** Saved state of the instance. Copied, since the save data might not outlive the load. */
+	TArray<uint8> Payload;
+};
+
+/** State shared by many loads, e.g. when restoring hundreds of inventories at once. */
+struct FInventoryLoadContext
+{
+	/** Definitions resolved by earlier loads, so each definition is only resolved once. */
+	TMap<FPrimaryAssetId, TWeakObjectPtr<UItemDefinitionBase>> ResolvedDefinitions;
+
+	/** Whether item instances are queued in DeferredInstances instead of being created right away. */
+	bool bDeferInstances = false;
+
+	/** Whether the instance payloads carry every property instead of only the SaveGame ones. See FInventorySerializer::Capture. */
+	bool bFullInstanceState = false;
+
+	/** Item instances still waiting to be created. */
+	TArray<FInventoryDeferredInstance> DeferredInstances;
+
+	/** Index of the next deferred instance to create. */
+	int32 NextDeferredInstance = 0;
+
+	/** Returns true if there are item instances left to create. */
+	bool HasDeferredInstances() const { return NextDeferredInstance < DeferredInstances.Num(); }
+};
+
+/** Called on the game thread once an asynchronous save has been written. */
+using FInventorySaveCompleted = TUniqueFunction<void(bool bSuccess)>;
+
+/**
+ * Compact, versioned binary serializer for inventories.
+ * Items with the TransientTag trait are never saved.
+ *
+ * Layout:
+ *	- Header:		Magic, schema version, inventory slot limit
+ *	- Tables:		Definition ids and stat tags, each written once per save
+ *	- Entries:		Handle, definition index, slot number, stat mask, stat values and instance payload as variable length integers
+ */
+class ITEMIZATIONCORERUNTIME_API FInventorySerializer
+{
+public:
+	/** Magic number at the start of every save. */
+	static constexpr uint32 Magic = 0x5A4D5449;
+
+	/** Magic number at the start of every compressed save. */
+	static constexpr uint32 CompressedMagic = 0x5A4D5443;
+
+	/**
+	 * Captures all persistent entries of the inventory. Game thread only.
+	 * @param bIncludeTransient		Whether items with the TransientTag trait are captured as well, e.g. when handing the inventory over to another server.
+	 * @param bFullInstanceState	Whether item instances keep all non-transient properties instead of only the SaveGame ones.
+	 *								Such captures have to be loaded with FInventoryLoadContext::bFullInstanceState set.
+	 */
+	static void Capture(const AInventoryBase& Inventory, FInventorySaveData& OutData, bool bIncludeTransient = false, bool bFullInstanceState = false);
+
+	/** Encodes previously captured save data. Can be called from any thread. */
+	static void Encode(const FInventorySaveData& Data, TArray<uint8>& OutBytes);
+
+	/** Captures and encodes the inventory right away. Game thread only. */
+	static void Save(const AInventoryBase& Inventory, TArray<uint8>& OutBytes);
+
+	/**
+	 * Captures the inventory on the game thread, then encodes, compresses and writes it to the given file on a background task.
+	 * The captured data is a plain copy, so the inventory can be changed again right away. Saves to the same file should
+	 * pass the previous save as prerequisite, so they are written in order.
+	 * @param OnCompleted	Called on the game thread once the file has been written.
+	 */
+	static UE::Tasks::FTask SaveAsync(const AInventoryBase& Inventory, const FString& FilePath,
+		FInventorySaveCompleted&& OnCompleted = nullptr, const UE::Tasks::FTask& Prerequisite = UE::Tasks::FTask());
+
+	/** Compresses an encoded save. Can be called from any thread. */
+	static void Compress(TConstArrayView<uint8> Bytes, TArray<uint8>& OutCompressed);
+
+	/** Decompresses a compressed save. Returns false if the data isn't a valid compressed save. */
+	static bool Decompress(TConstArrayView<uint8> Compressed, TArray<uint8>& OutBytes);
+
+	/**
+	 * Decodes a save straight into the item list of an empty inventory. Game thread only.
+	 * The list is allocated once up front and entries are restored as they were saved, without evaluating them again.
+	 * Entries whose definition can't be resolved anymore are dropped. Accepts compressed and uncompressed saves.
+	 * @param Context	Optional state shared with other loads, which also decides whether instance creation is deferred.
+	 */
+	static bool Load(AInventoryBase& Inventory, TConstArrayView<uint8> Bytes, FInventoryLoadContext* Context = nullptr);
+
+	/**
+	 * Creates item instances whose creation has been deferred by previous loads. Game thread only.
+	 * @param MaxSeconds	Time budget of this call. Values <= 0 create all remaining instances.
+	 * @return The number of instances created.
+	 */
+	static int32 CreateDeferredInstances(FInventoryLoadContext& Context, double MaxSeconds = 0.0);
+};
\ No newline at end of file
@@ -0,0 +1,69 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/** A single encoded inventory handed to or read from a storage provider. */
+struct FInventoryStorageRecord
+{
+	/** Unique key of the inventory within the storage. */
+	FString Key;
+
+	/** The encoded inventory, as written by FInventorySerializer. */
+	TArray<uint8> Bytes;
+};
+
+/** Called on the game thread once a batch has been written, with the keys that couldn't be written. */
+using FInventoryStorageWriteCompleted = TUniqueFunction<void(TArray<FString>&& FailedKeys)>;
+
+/** Called on the game thread once a batch has been read, with all records that have been found. */
+using FInventoryStorageReadCompleted = TUniqueFunction<void(TArray<FInventoryStorageRecord>&& Records)>;
+
+/**
+ * Storage that persists encoded inventories, e.g. a local directory or a remote backend.
+ * Providers always work on batches of many inventories, so implementations can pack them into a single request.
+ */
+class IInventoryStorageProvider
+{
+public:
+	virtual ~IInventoryStorageProvider() {}
+
+	/** Writes a batch of inventories. Can be called from any thread. */
+	virtual void WriteBatch(TArray<FInventoryStorageRecord>&& Records, FInventoryStorageWriteCompleted&& OnCompleted) = 0;
+
+	/** Reads a batch of inventories. Reads always observe all writes issued before. Can be called from any thread. */
+	virtual void ReadBatch(TArray<FString>&& Keys, FInventoryStorageReadCompleted&& OnCompleted) = 0;
+
+	/** Blocks until all pending writes have finished. */
+	virtual void Flush() = 0;
+};
+
+/**
+ * Storage provider writing every inventory as its own file into a local directory.
+ * Meant for local development and load tests. Each batch is written by a single background task, one after another.
+ */
+class ITEMIZATIONCORERUNTIME_API FInventoryLocalFileStorageProvider : public IInventoryStorageProvider
+{
+public:
+	explicit FInventoryLocalFileStorageProvider(const FString& InDirectory);
+	virtual ~FInventoryLocalFileStorageProvider() override;
+
+	//~ Begin IInventoryStorageProvider Interface
+	virtual void WriteBatch(TArray<FInventoryStorageRecord>&& Records, FInventoryStorageWriteCompleted&& OnCompleted) override;
+	virtual void ReadBatch(TArray<FString>&& Keys, FInventoryStorageReadCompleted&& OnCompleted) override;
+	virtual void Flush() override;
+	//~ End IInventoryStorageProvider Interface
+
+	/** Returns the file the inventory with the given key is stored in. */
+	static FString GetFilePath(const FString& Directory, const FString& Key);
+
+private:
+	/** Directory all inventories are stored in. */
+	FString Directory;
+
+	/** The last launched batch. Every batch waits for the one before, so writes of the same key land in order. */
+	UE::Tasks::FTask LastBatch;
+	FCriticalSection BatchLock;
+};
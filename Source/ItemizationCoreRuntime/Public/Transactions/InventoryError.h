@@ -117,6 +117,12 @@ inline FString ToLogString(const FInventoryError& Error)
 	return Error.GetLogString();
 }
 
+/** Creates a new error holding the given log string and display text. */
+inline FInventoryError MakeInventoryError(FString&& LogString, FText&& Text)
+{
+	return FInventoryError(MakeShared<const FInventoryErrorDetails, ESPMode::ThreadSafe>(MoveTemp(LogString), MoveTemp(Text)));
+}
+
 #if UE_ENABLE_INCLUDE_ORDER_DEPRECATED_IN_5_2
 #include "CoreMinimal.h"
 #endif
@@ -0,0 +1,82 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+
+#include "InventoryItemHandle.h"
+#include "Hash/CityHash.h"
+#include "InventoryResult.h"
+#include "InventoryTrackableOp.h"
+
+class AInventoryBase;
+class UItemDefinitionBase;
+class UObject;
+
+struct ITEMIZATIONCORERUNTIME_API FInventoryItemGiveOp : public FInventoryTrackableOp
+{
+	static constexpr TCHAR Name[] = TEXT("GiveItem");
+
+public:
+	struct Params
+	{
+		/** The item definition to give. Only weakly referenced, the op fails if it has been destroyed before it ran. */
+		TWeakObjectPtr<UItemDefinitionBase> ItemDefinition;
+
+		/** The number of items to give. */
+		int32 StackCount = 0;
+
+		/** Optional source object of the items. */
+		TWeakObjectPtr<UObject> SourceObject;
+	};
+
+	struct Result
+	{
+		/** Handle to the last item entry that received items. */
+		FInventoryItemHandle ItemHandle;
+
+		/** Number of items that didn't fit into the inventory. */
+		int32 Excess = 0;
+	};
+
+	/** Executes the op on the given inventory. Game thread only. */
+	static TInventoryTransactionResult<FInventoryItemGiveOp> Execute(AInventoryBase& Inventory, const Params& InParams);
+
+	/**
+	 * Pending gives of the same item definition and source object within a frame are merged into a single give.
+	 * Gives from different sources stay separate, so every given entry keeps its own source. Only called on the game thread.
+	 */
+	static uint64 GetCoalescingKey(const Params& InParams)
+	{
+		// A destroyed definition yields 0, so the op runs on its own and reports the error
+		const UItemDefinitionBase* ItemDefinition = InParams.ItemDefinition.Get();
+		if (InParams.StackCount <= 0 || ItemDefinition == nullptr)
+		{
+			return 0;
+		}
+
+		const uint64 Key = CityHash128to64(Uint128_64(
+			static_cast<uint64>(reinterpret_cast<UPTRINT>(ItemDefinition)),
+			static_cast<uint64>(reinterpret_cast<UPTRINT>(InParams.SourceObject.Get()))));
+		return Key != 0 ? Key : 1;
+	}
+
+	/** The coalescing key is a hash, so gives are only merged if they really share the item definition and source object. */
+	static bool CanCoalesce(const Params& A, const Params& B)
+	{
+		return A.ItemDefinition == B.ItemDefinition && A.SourceObject == B.SourceObject;
+	}
+
+	static void CoalesceParams(Params& Into, const Params& Other)
+	{
+		Into.StackCount += Other.StackCount;
+	}
+
+	static Result SplitResult(Result& Remaining, const Params& InParams)
+	{
+		Result Share;
+		Share.ItemHandle = Remaining.ItemHandle;
+		Share.Excess = FMath::Min(Remaining.Excess, InParams.StackCount);
+		Remaining.Excess -= Share.Excess;
+		return Share;
+	}
+};
\ No newline at end of file
@@ -3,12 +3,14 @@
 #pragma once
 
 
+#include "InventoryItemHandle.h"
+#include "InventoryResult.h"
 #include "InventoryTrackableOp.h"
 
 struct FGameplayTagContainer;
 class AInventoryBase;
 
-struct FInventoryItemMoveOp : public FInventoryTrackableOp
+struct ITEMIZATIONCORERUNTIME_API FInventoryItemMoveOp : public FInventoryTrackableOp
 {
 	static constexpr TCHAR Name[] = TEXT("MoveItem");
 	
@@ -21,15 +23,25 @@ public:
 		/** The target inventory to which items are moved. */
 		TWeakObjectPtr<AInventoryBase> TargetInventory;
 
+		/** The item in the source inventory to move. */
+		FInventoryItemHandle ItemHandle;
+
 		/** Optional context data for the move action. */
 		FGameplayTagContainer* Context = nullptr;
 
-		/** The item to be moved. */
+		/** The number of items to move. Values <= 0 move the entire stack. */
 		int32 Delta = 0;
 	};
 
 	struct Result
 	{
+		/** Handle to the item entry in the target inventory that received the items. */
+		FInventoryItemHandle TargetItemHandle;
+
+		/** Number of items that couldn't be moved and stayed in the source inventory. */
 		int32 Excess = 0;
 	};
-};
+
+	/** Executes the op. The inventory is the one the op has been queued on. Game thread only. */
+	static TInventoryTransactionResult<FInventoryItemMoveOp> Execute(AInventoryBase& Inventory, const Params& InParams);
+};
\ No newline at end of file
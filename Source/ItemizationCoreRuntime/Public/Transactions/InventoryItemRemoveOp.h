@@ -0,0 +1,53 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+
+#include "InventoryItemHandle.h"
+#include "InventoryResult.h"
+#include "InventoryTrackableOp.h"
+
+class AInventoryBase;
+
+struct ITEMIZATIONCORERUNTIME_API FInventoryItemRemoveOp : public FInventoryTrackableOp
+{
+	static constexpr TCHAR Name[] = TEXT("RemoveItem");
+
+public:
+	struct Params
+	{
+		/** The item to remove items from. */
+		FInventoryItemHandle ItemHandle;
+
+		/** The number of items to remove. Values <= 0 remove the entire stack. */
+		int32 Delta = 0;
+	};
+
+	struct Result
+	{
+		/** Number of items that couldn't be removed. */
+		int32 Missing = 0;
+	};
+
+	/** Executes the op on the given inventory. Game thread only. */
+	static TInventoryTransactionResult<FInventoryItemRemoveOp> Execute(AInventoryBase& Inventory, const Params& InParams);
+
+	/** Pending removes from the same item within a frame are merged into a single remove. Removing the entire stack is never merged. */
+	static uint64 GetCoalescingKey(const Params& InParams)
+	{
+		return InParams.Delta > 0 ? InParams.ItemHandle.Get() : 0;
+	}
+
+	static void CoalesceParams(Params& Into, const Params& Other)
+	{
+		Into.Delta += Other.Delta;
+	}
+
+	static Result SplitResult(Result& Remaining, const Params& InParams)
+	{
+		Result Share;
+		Share.Missing = FMath::Min(Remaining.Missing, InParams.Delta);
+		Remaining.Missing -= Share.Missing;
+		return Share;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,74 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+
+#include "InventoryItemHandle.h"
+#include "InventoryResult.h"
+#include "InventoryTrackableOp.h"
+
+struct FGameplayTagContainer;
+class AInventoryBase;
+
+/** A single stack offered by one side of a trade. */
+struct FInventoryTradeOffer
+{
+	FInventoryTradeOffer() = default;
+	FInventoryTradeOffer(const FInventoryItemHandle& InItemHandle, int32 InCount)
+		: ItemHandle(InItemHandle)
+		, Count(InCount)
+	{
+	}
+
+	/** The offered item in the inventory of the offering side. */
+	FInventoryItemHandle ItemHandle;
+
+	/** The number of items offered. Values <= 0 offer the entire stack. */
+	int32 Count = 0;
+};
+
+/**
+ * Atomic exchange of items between two inventories.
+ * Both sides are validated up front, including whether the received items fit after the offered items left.
+ * If anything doesn't pass, neither inventory is touched. Otherwise both sides are committed in the order of their
+ * inventory guid, and all notifications are held back until both sides are done, so nobody observes a half applied trade.
+ * Traded items keep their stats and instance state. Entire stacks keep their item handle on the receiving side if they get a stack of their own.
+ */
+struct ITEMIZATIONCORERUNTIME_API FInventoryItemTradeOp : public FInventoryTrackableOp
+{
+	static constexpr TCHAR Name[] = TEXT("TradeItems");
+
+public:
+	struct Params
+	{
+		/** The first side of the trade. Defaults to the inventory the op has been queued on. */
+		TWeakObjectPtr<AInventoryBase> InventoryA;
+
+		/** The second side of the trade. */
+		TWeakObjectPtr<AInventoryBase> InventoryB;
+
+		/** Items that move from inventory A to inventory B. */
+		TArray<FInventoryTradeOffer> OffersA;
+
+		/** Items that move from inventory B to inventory A. */
+		TArray<FInventoryTradeOffer> OffersB;
+
+		/** Optional context data for the trade. */
+		FGameplayTagContainer* Context = nullptr;
+	};
+
+	struct Result
+	{
+		/** Handles to the item entries in inventory A that received items, in the order of OffersB. */
+		TArray<FInventoryItemHandle> ReceivedByA;
+
+		/** Handles to the item entries in inventory B that received items, in the order of OffersA. */
+		TArray<FInventoryItemHandle> ReceivedByB;
+	};
+
+	/** Executes the op. The inventory is the one the op has been queued on. Game thread only. */
+	static TInventoryTransactionResult<FInventoryItemTradeOp> Execute(AInventoryBase& Inventory, const Params& InParams);
+
+	/** Returns true if the first inventory has to be committed before the second one. Orders by inventory guid. */
+	static bool CommitsBefore(const AInventoryBase& First, const AInventoryBase& Second);
+};
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "InventoryOperation.h"
 #include "InventoryOpHandle.h"
+#include "Containers/Queue.h"
+
+class AInventoryBase;
 
 class IInventoryDataOp
 {
@@ -57,6 +60,167 @@ protected:
 	T Data;
 };
 
+/** Type erased operation waiting in the queue of an op cache. */
+class IPendingInventoryOp
+{
+public:
+	virtual ~IPendingInventoryOp() {}
+
+	/** Returns a key identifying the type of the operation. */
+	virtual UPTRINT GetOpTypeKey() const = 0;
+
+	/** Returns the display name of the operation type. */
+	virtual const TCHAR* GetOpTypeName() const = 0;
+
+	/** Returns the key used to merge operations of the same type. 0 if the operation can't be merged. */
+	virtual uint64 GetCoalescingKey() const = 0;
+
+	/** Checks whether this operation can be merged with another one of the same type and coalescing key, e.g. if the key is a hash. */
+	virtual bool CanCoalesceWith(const IPendingInventoryOp& Other) const = 0;
+
+	/** Executes the operation on the given inventory. A null inventory cancels the operation. */
+	virtual void Execute(AInventoryBase* Inventory) = 0;
+
+	/** Executes this operation merged with other operations of the same type and coalescing key. */
+	virtual void ExecuteCoalesced(AInventoryBase& Inventory, TConstArrayView<IPendingInventoryOp*> Others) = 0;
+};
+
+/**
+ * Pending operation of a specific type.
+ * OpType has to provide a static Execute(AInventoryBase&, const Params&) returning its transaction result.
+ * To be merged with other pending operations, OpType additionally has to provide:
+ *	- static uint64 GetCoalescingKey(const Params&)			Ops with the same non-zero key are merged.
+ *	- static void CoalesceParams(Params& Into, const Params&)	Adds the params of another op to the merged params.
+ *	- static Result SplitResult(Result& Remaining, const Params&)	Takes the share of a single op out of the merged result.
+ *																		Called from the latest to the earliest op.
+ * Optionally, OpType can provide:
+ *	- static bool CanCoalesce(const Params&, const Params&)		Whether two ops with the same key really match.
+ *																		Needed if the key can collide, ops that don't match run on their own.
+ */
+template <typename OpType>
+class TPendingInventoryOp final : public IPendingInventoryOp
+{
+public:
+	using ParamsType = typename OpType::Params;
+	using ResultType = typename OpType::Result;
+
+	static constexpr bool bCanCoalesce = requires(ParamsType& P, ResultType& R)
+	{
+		OpType::GetCoalescingKey(P);
+		OpType::CoalesceParams(P, P);
+		OpType::SplitResult(R, P);
+	};
+
+	explicit TPendingInventoryOp(const TInventoryOpRef<OpType>& InOperation)
+		: Operation(InOperation)
+	{
+	}
+
+	virtual UPTRINT GetOpTypeKey() const override
+	{
+		return reinterpret_cast<UPTRINT>(OpType::Name);
+	}
+
+	virtual const TCHAR* GetOpTypeName() const override
+	{
+		return OpType::Name;
+	}
+
+	virtual uint64 GetCoalescingKey() const override
+	{
+		if constexpr (bCanCoalesce)
+		{
+			return OpType::GetCoalescingKey(Operation->GetParams());
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	virtual bool CanCoalesceWith(const IPendingInventoryOp& Other) const override
+	{
+		if constexpr (bCanCoalesce && requires(const ParamsType& P) { OpType::CanCoalesce(P, P); })
+		{
+			return Other.GetOpTypeKey() == GetOpTypeKey() &&
+				OpType::CanCoalesce(Operation->GetParams(), static_cast<const TPendingInventoryOp&>(Other).Operation->GetParams());
+		}
+		else
+		{
+			return bCanCoalesce && Other.GetOpTypeKey() == GetOpTypeKey();
+		}
+	}
+
+	virtual void Execute(AInventoryBase* Inventory) override
+	{
+		if (Inventory)
+		{
+			Operation->Complete(OpType::Execute(*Inventory, Operation->GetParams()));
+		}
+		else
+		{
+			Operation->SetError(MakeInventoryError(
+				FString::Printf(TEXT("%s has been cancelled"), OpType::Name),
+				NSLOCTEXT("InventoryOpCache", "OpCancelled", "The inventory operation has been cancelled.")));
+		}
+	}
+
+	virtual void ExecuteCoalesced(AInventoryBase& Inventory, TConstArrayView<IPendingInventoryOp*> Others) override
+	{
+		if constexpr (bCanCoalesce)
+		{
+			TArray<TPendingInventoryOp*, TInlineAllocator<8>> Ops;
+			Ops.Add(this);
+			for (IPendingInventoryOp* Other : Others)
+			{
+				check(Other->GetOpTypeKey() == GetOpTypeKey());
+				Ops.Add(static_cast<TPendingInventoryOp*>(Other));
+			}
+
+			ParamsType MergedParams = Operation->GetParams();
+			for (int32 Idx = 1; Idx < Ops.Num(); ++Idx)
+			{
+				OpType::CoalesceParams(MergedParams, Ops[Idx]->Operation->GetParams());
+			}
+
+			const TInventoryTransactionResult<OpType> MergedResult = OpType::Execute(Inventory, MergedParams);
+			if (MergedResult.IsError())
+			{
+				for (TPendingInventoryOp* Op : Ops)
+				{
+					Op->Operation->Complete(TInventoryTransactionResult<OpType>(MergedResult.GetErrorValue()));
+				}
+				return;
+			}
+
+			// Shortfalls hit the latest ops first, but complete the ops in the order they have been queued
+			ResultType Remaining = MergedResult.GetOkValue();
+			TArray<ResultType, TInlineAllocator<8>> Shares;
+			Shares.SetNum(Ops.Num());
+			for (int32 Idx = Ops.Num() - 1; Idx >= 0; --Idx)
+			{
+				Shares[Idx] = OpType::SplitResult(Remaining, Ops[Idx]->Operation->GetParams());
+			}
+
+			for (int32 Idx = 0; Idx < Ops.Num(); ++Idx)
+			{
+				Ops[Idx]->Operation->Complete(TInventoryTransactionResult<OpType>(MoveTemp(Shares[Idx])));
+			}
+		}
+		else
+		{
+			Execute(&Inventory);
+			for (IPendingInventoryOp* Other : Others)
+			{
+				Other->Execute(&Inventory);
+			}
+		}
+	}
+
+private:
+	TInventoryOpRef<OpType> Operation;
+};
+
 /** Cache used to store multiple inventory operations. */
 class FInventoryOpCache
 {
@@ -65,11 +229,54 @@ public:
 	template <typename OpType>
 	TInventoryOpRef<OpType> GetOperation(typename OpType::Params&& Params)
 	{
-		TSharedRef<TInventoryOperation<OpType>> Operation =
-			MakeShared<TInventoryOperation<OpType>>(MoveTemp(Params));
+		TInventoryOpRef<OpType> Operation =
+			MakeShared<TInventoryOperation<OpType>, ESPMode::ThreadSafe>(MoveTemp(Params));
 
 		return Operation;
 	}
+
+	/**
+	 * Creates a new operation and queues it for execution on the game thread. Can be called from any thread.
+	 * OpType has to provide a static Execute(AInventoryBase&, const Params&) returning its transaction result.
+	 *
+	 * @param Params		The params of the operation.
+	 * @param bOutWasEmpty	True, if this is the first pending operation and the owner has to schedule a flush.
+	 */
+	template <typename OpType>
+	TInventoryOpHandle<OpType> EnqueueOperation(typename OpType::Params&& Params, bool& bOutWasEmpty)
+	{
+		TInventoryOpRef<OpType> Operation = GetOperation<OpType>(MoveTemp(Params));
+		TInventoryOpHandle<OpType> Handle = Operation->GetHandle();
+		Operation->Start();
+
+		PendingOperations.Enqueue(MakeUnique<TPendingInventoryOp<OpType>>(Operation));
+
+		bOutWasEmpty = NumPendingOperations.fetch_add(1) == 0;
+		return Handle;
+	}
+
+	/**
+	 * Executes all operations that were pending when this got called, in the order they have been queued.
+	 * Pending operations of the same type and coalescing key are merged and executed once, at the position of the first one.
+	 * Operations queued while executing are left for the next call. Game thread only.
+	 */
+	ITEMIZATIONCORERUNTIME_API void ExecutePendingOperations(AInventoryBase& Inventory);
+
+	/** Completes all pending operations with an error without executing them. */
+	ITEMIZATIONCORERUNTIME_API void CancelPendingOperations();
+
+	/** Returns true if there are operations waiting to be executed. */
+	bool HasPendingOperations() const
+	{
+		return NumPendingOperations.load() > 0;
+	}
+
+	/** Returns the number of operations waiting to be executed. */
+	int32 GetNumPendingOperations() const
+	{
+		return NumPendingOperations.load();
+	}
+
 protected:
 private:
 	class IWrappedInventoryOp : public IInventoryDataOp
@@ -96,4 +303,8 @@ private:
 	};
 	
 	TMap<int32, TUniquePtr<IWrappedInventoryOp>> Operations;
+
+	/** Operations waiting to be executed. */
+	TQueue<TUniquePtr<IPendingInventoryOp>, EQueueMode::Mpsc> PendingOperations;
+	std::atomic<int32> NumPendingOperations = 0;
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "InventoryResult.h"
+#include "Tasks/Task.h"
 
 enum class EInventoryOpState : uint8
 {
@@ -26,8 +28,12 @@ namespace Private
 	class IInventoryOpSharedState
 	{
 	public:
+		using FCompletionCallback = TUniqueFunction<void(const TInventoryTransactionResult<OpType>&)>;
+
 		virtual ~IInventoryOpSharedState() {}
 		virtual EInventoryOpState GetState() const = 0;
+		virtual const TInventoryTransactionResult<OpType>* TryGetResult() const = 0;
+		virtual void OnComplete(FCompletionCallback&& Callback) = 0;
 	};
 }
 
@@ -36,16 +42,49 @@ template <typename OpType>
 class TInventoryOpHandle
 {
 public:
-	TInventoryOpHandle(TSharedRef<Private::IInventoryOpSharedState<OpType>>&& InSharedState)
+	TInventoryOpHandle(TSharedRef<Private::IInventoryOpSharedState<OpType>, ESPMode::ThreadSafe>&& InSharedState)
 		: State(MoveTemp(InSharedState))
 	{
 	}
 
+	using FCompletionCallback = typename Private::IInventoryOpSharedState<OpType>::FCompletionCallback;
+
 	/** Returns the state of the op. */
 	EInventoryOpState GetState() const
 	{
 		return State->GetState();
 	}
+
+	/** Returns the result of the op or nullptr if it hasn't completed yet. */
+	const TInventoryTransactionResult<OpType>* TryGetResult() const
+	{
+		return State->TryGetResult();
+	}
+
+	/**
+	 * Registers a callback that gets invoked with the result once the op completed.
+	 * Called right away if the op has already completed, otherwise on the thread that completes the op (usually the game thread).
+	 */
+	void OnComplete(FCompletionCallback&& Callback) const
+	{
+		State->OnComplete(MoveTemp(Callback));
+	}
+
+	/** Returns a task that completes with the result of the op. Can be used as prerequisite for other tasks. */
+	UE::Tasks::TTask<TInventoryTransactionResult<OpType>> AsTask() const
+	{
+		UE::Tasks::FTaskEvent CompletionEvent(UE_SOURCE_LOCATION);
+		OnComplete([CompletionEvent](const TInventoryTransactionResult<OpType>&) mutable
+		{
+			CompletionEvent.Trigger();
+		});
+
+		return UE::Tasks::Launch(UE_SOURCE_LOCATION, [SharedState = State]()
+		{
+			return *SharedState->TryGetResult();
+		}, CompletionEvent);
+	}
+
 private:
-	TSharedPtr<Private::IInventoryOpSharedState<OpType>> State;
+	TSharedPtr<Private::IInventoryOpSharedState<OpType>, ESPMode::ThreadSafe> State;
 };
\ No newline at end of file
@@ -42,14 +42,15 @@ template <typename OpType>
 class TInventoryOperation
 	: public Private::TInventoryOpBase<TInventoryOperation<OpType>, OpType, void>
 	, public FInventoryOperation
-	, public TSharedFromThis<TInventoryOperation<OpType>>
+	, public TSharedFromThis<TInventoryOperation<OpType>, ESPMode::ThreadSafe>
 {
 public:
 	using ParamsType = typename OpType::Params;
 	using ResultType = typename OpType::Result;
+	using FCompletionCallback = typename Private::IInventoryOpSharedState<OpType>::FCompletionCallback;
 
 	TInventoryOperation(ParamsType&& Params)
-		: SharedState(MakeShared<FInventoryOpSharedState>(MoveTemp(Params)))
+		: SharedState(MakeShared<FInventoryOpSharedState, ESPMode::ThreadSafe>(MoveTemp(Params)))
 	{
 	}
 
@@ -57,12 +58,12 @@ public:
 
 	bool IsComplete() const
 	{
-		return SharedState->State <= EInventoryOpState::Completed;
+		return SharedState->IsComplete();
 	}
 
 	EInventoryOpState GetState() const
 	{
-		return SharedState->State;
+		return SharedState->State.load();
 	}
 
 	const ParamsType& GetParams() const
@@ -85,11 +86,38 @@ public:
 		SetResultAndSate(TInventoryTransactionResult<OpType>(MoveTemp(Error)), EInventoryOpState::Completed);
 	}
 
+	/** Marks the op as running. Called once the op has been queued for execution. */
+	void Start()
+	{
+		SharedState->State = EInventoryOpState::Running;
+	}
+
+	/** Completes the op with the given result. */
+	void Complete(TInventoryTransactionResult<OpType>&& Result)
+	{
+		SetResultAndSate(MoveTemp(Result), EInventoryOpState::Completed);
+	}
+
 protected:
 	void SetResultAndSate(TInventoryTransactionResult<OpType>&& Result, EInventoryOpState State)
 	{
-		SharedState->Result = MoveTemp(Result);
-		SharedState->State = State;
+		TArray<FCompletionCallback> Continuations;
+		{
+			FScopeLock Lock(&SharedState->ContinuationLock);
+			SharedState->Result = MoveTemp(Result);
+			SharedState->State = State;
+
+			if (SharedState->IsComplete())
+			{
+				Continuations = MoveTemp(SharedState->Continuations);
+			}
+		}
+
+		// Invoke outside the lock, continuations might queue up new ops or register further continuations
+		for (FCompletionCallback& Continuation : Continuations)
+		{
+			Continuation(SharedState->Result);
+		}
 	}
 	
 	class FInventoryOpSharedState
@@ -102,20 +130,42 @@ protected:
 		
 		ParamsType Params;
 		TInventoryTransactionResult<OpType> Result;
-		EInventoryOpState State = EInventoryOpState::Invalid;
+
+		/** Written by the game thread, but might be polled from any thread. The result is valid once this is Completed. */
+		std::atomic<EInventoryOpState> State = EInventoryOpState::Invalid;
 
 		bool IsComplete() const
 		{
-			return State >= EInventoryOpState::Completed;
+			return State.load() >= EInventoryOpState::Completed;
 		}
+
+		void OnComplete(FCompletionCallback&& Callback)
+		{
+			{
+				FScopeLock Lock(&ContinuationLock);
+				if (!IsComplete())
+				{
+					Continuations.Add(MoveTemp(Callback));
+					return;
+				}
+			}
+
+			Callback(Result);
+		}
+
+		/** Guards the continuations and the transition into the completed state. */
+		FCriticalSection ContinuationLock;
+
+		/** Callbacks to invoke once the op completed. */
+		TArray<FCompletionCallback> Continuations;
 	};
 
 	class FInventoryOpSharedHandleState
 		: public Private::IInventoryOpSharedState<OpType>
-		, public TSharedFromThis<FInventoryOpSharedHandleState>
+		, public TSharedFromThis<FInventoryOpSharedHandleState, ESPMode::ThreadSafe>
 	{
 	public:
-		FInventoryOpSharedHandleState(const TSharedRef<TInventoryOperation<OpType>>& InOp)
+		FInventoryOpSharedHandleState(const TSharedRef<TInventoryOperation<OpType>, ESPMode::ThreadSafe>& InOp)
 			: SharedState(InOp->SharedState)
 			, Op(InOp)
 		{
@@ -123,27 +173,38 @@ protected:
 		
 		virtual EInventoryOpState GetState() const override
 		{
-			return SharedState->State;
+			return SharedState->State.load();
+		}
+
+		virtual const TInventoryTransactionResult<OpType>* TryGetResult() const override
+		{
+			return SharedState->IsComplete() ? &SharedState->Result : nullptr;
+		}
+
+		virtual void OnComplete(FCompletionCallback&& Callback) override
+		{
+			SharedState->OnComplete(MoveTemp(Callback));
 		}
 		
 	private:
-		TSharedRef<FInventoryOpSharedState> SharedState;
-		TWeakPtr<TInventoryOperation<OpType>> Op;
+		TSharedRef<FInventoryOpSharedState, ESPMode::ThreadSafe> SharedState;
+		TWeakPtr<TInventoryOperation<OpType>, ESPMode::ThreadSafe> Op;
 	};
 
-	TSharedRef<Private::IInventoryOpSharedState<OpType>> CreateSharedState()
+	TSharedRef<Private::IInventoryOpSharedState<OpType>, ESPMode::ThreadSafe> CreateSharedState()
 	{
-		TSharedRef<FInventoryOpSharedHandleState> NewHandleState = MakeShared<FInventoryOpSharedHandleState>(this->AsShared());
+		TSharedRef<FInventoryOpSharedHandleState, ESPMode::ThreadSafe> NewHandleState =
+			MakeShared<FInventoryOpSharedHandleState, ESPMode::ThreadSafe>(this->AsShared());
 		SharedHandleStates.Add(NewHandleState);
 		return StaticCastSharedRef<Private::IInventoryOpSharedState<OpType>>(NewHandleState);
 	}
 
-	TSharedRef<FInventoryOpSharedState> SharedState;
-	TArray<TSharedRef<FInventoryOpSharedHandleState>> SharedHandleStates;
+	TSharedRef<FInventoryOpSharedState, ESPMode::ThreadSafe> SharedState;
+	TArray<TSharedRef<FInventoryOpSharedHandleState, ESPMode::ThreadSafe>> SharedHandleStates;
 };
 
 
 template <typename OpType>
-using TInventoryOpRef = TSharedRef<TInventoryOperation<OpType>>;
+using TInventoryOpRef = TSharedRef<TInventoryOperation<OpType>, ESPMode::ThreadSafe>;
 template <typename OpType>
-using TInventoryOpPtr = TSharedPtr<TInventoryOperation<OpType>>;
\ No newline at end of file
+using TInventoryOpPtr = TSharedPtr<TInventoryOperation<OpType>, ESPMode::ThreadSafe>;
\ No newline at end of file
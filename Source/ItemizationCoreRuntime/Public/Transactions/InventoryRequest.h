@@ -0,0 +1,142 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "InventoryItemHandle.h"
+#include "InventorySlotHandle.h"
+#include "InventoryTrackableOp.h"
+
+#include "InventoryRequest.generated.h"
+
+class AInventoryBase;
+class UPackageMap;
+
+/** Type of change a client can request on its inventory. */
+UENUM(BlueprintType)
+enum class EInventoryRequestType : uint8
+{
+	/** Removes items from a stack. */
+	Remove = 0x0			UMETA(DisplayName = "Remove"),
+
+	/** Moves items from a stack into another inventory of the same owner. */
+	Move = 0x1				UMETA(DisplayName = "Move"),
+
+	/** Places an item into a slot group of the inventory. */
+	Place = 0x2				UMETA(DisplayName = "Place"),
+
+	MAX						UMETA(Hidden)
+};
+
+/** Result of a single client request, as acknowledged by the server. */
+UENUM(BlueprintType)
+enum class EInventoryRequestResult : uint8
+{
+	/** The request has been applied. */
+	Succeeded = 0x0			UMETA(DisplayName = "Succeeded"),
+
+	/** The request was valid but couldn't be applied, e.g. because there was no room left. */
+	Failed = 0x1			UMETA(DisplayName = "Failed"),
+
+	/** The request didn't pass validation. */
+	Invalid = 0x2			UMETA(DisplayName = "Invalid"),
+
+	/** The request has been dropped, because the client exceeded its request budget. */
+	RateLimited = 0x3		UMETA(DisplayName = "Rate Limited"),
+};
+
+/** Single inventory change requested by a client. */
+USTRUCT(BlueprintType)
+struct ITEMIZATIONCORERUNTIME_API FInventoryRequest : public FInventoryTrackableOp
+{
+	GENERATED_BODY()
+
+public:
+	/** Compact serialization used by the request batch. Only writes the fields used by the request type. */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/** The type of the request. */
+	UPROPERTY(BlueprintReadWrite, Category=Request)
+	EInventoryRequestType Type = EInventoryRequestType::Remove;
+
+	/** The item the request refers to. */
+	UPROPERTY(BlueprintReadWrite, Category=Request)
+	FInventoryItemHandle ItemHandle;
+
+	/** The number of items to remove or move. Values <= 0 refer to the entire stack. */
+	UPROPERTY(BlueprintReadWrite, Category=Request)
+	int32 Delta = 0;
+
+	/** Target inventory of a move request. */
+	UPROPERTY(BlueprintReadWrite, Category=Request)
+	TWeakObjectPtr<AInventoryBase> TargetInventory;
+
+	/** Slot group of a place request. */
+	UPROPERTY(BlueprintReadWrite, Category=Request)
+	FGameplayTag GroupTag;
+
+	/** Origin slot of a place request. */
+	UPROPERTY(BlueprintReadWrite, Category=Request)
+	FInventorySlotHandle SlotOrigin;
+
+	/** Whether the item should be placed rotated. */
+	UPROPERTY(BlueprintReadWrite, Category=Request)
+	bool bRotated = false;
+};
+
+/** Batch of client requests sent to the server with a single RPC. */
+USTRUCT()
+struct ITEMIZATIONCORERUNTIME_API FInventoryRequestBatch
+{
+	GENERATED_BODY()
+
+public:
+	/** Maximum number of requests the server accepts in a single batch. */
+	static constexpr int32 MaxNumRequests = 256;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/** Client side sequence number of this batch. */
+	UPROPERTY()
+	uint32 BatchId = 0;
+
+	/** The requests in the order they have been issued. */
+	UPROPERTY()
+	TArray<FInventoryRequest> Requests;
+};
+
+template <>
+struct TStructOpsTypeTraits<FInventoryRequestBatch> : public TStructOpsTypeTraitsBase2<FInventoryRequestBatch>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/** Server acknowledgement of a request batch. */
+USTRUCT(BlueprintType)
+struct ITEMIZATIONCORERUNTIME_API FInventoryRequestAck
+{
+	GENERATED_BODY()
+
+public:
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/** The batch this acknowledgement belongs to. */
+	UPROPERTY(BlueprintReadOnly, Category=Request)
+	uint32 BatchId = 0;
+
+	/** Result per request, in the order of the batch. */
+	UPROPERTY(BlueprintReadOnly, Category=Request)
+	TArray<EInventoryRequestResult> Results;
+};
+
+template <>
+struct TStructOpsTypeTraits<FInventoryRequestAck> : public TStructOpsTypeTraitsBase2<FInventoryRequestAck>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
\ No newline at end of file
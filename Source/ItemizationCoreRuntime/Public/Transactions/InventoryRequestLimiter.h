@@ -0,0 +1,134 @@
+// Author: Tom Werner (MajorT), 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+#include "InventoryRequestLimiter.generated.h"
+
+class UNetConnection;
+enum class EInventoryRequestType : uint8;
+
+/** Configures a token bucket that limits how many client requests can be processed. */
+USTRUCT()
+struct ITEMIZATIONCORERUNTIME_API FInventoryRequestBudget
+{
+	GENERATED_BODY()
+
+	FInventoryRequestBudget() = default;
+	FInventoryRequestBudget(float InCapacity, float InRefillRate)
+		: Capacity(InCapacity)
+		, RefillRate(InRefillRate)
+	{
+	}
+
+	/** Returns true if this budget limits anything at all. */
+	bool IsEnabled() const
+	{
+		return Capacity > 0.f;
+	}
+
+	/** Maximum amount of tokens that can be accumulated. This is the largest burst of requests that is accepted. Set to 0 to disable the limit. */
+	UPROPERTY(EditDefaultsOnly, Category=Budget, meta=(ClampMin=0))
+	float Capacity = 0.f;
+
+	/** Amount of tokens that are refilled per second. This is the sustained request cost that is accepted. */
+	UPROPERTY(EditDefaultsOnly, Category=Budget, meta=(ClampMin=0))
+	float RefillRate = 0.f;
+};
+
+/** Token bucket that is refilled over time and drained by the cost of each processed request. */
+struct ITEMIZATIONCORERUNTIME_API FInventoryRequestTokenBucket
+{
+public:
+	/** Refills the bucket for the time passed since the last refill. */
+	void Refill(const FInventoryRequestBudget& Budget, double CurrentTime);
+
+	/** Returns true if the bucket holds enough tokens to pay for the given cost. */
+	bool CanAfford(float Cost) const
+	{
+		return Tokens >= Cost;
+	}
+
+	/** Removes the given cost from the bucket. */
+	void Consume(float Cost)
+	{
+		Tokens -= Cost;
+	}
+
+	/** Returns the amount of tokens currently left in the bucket. */
+	float GetTokens() const
+	{
+		return Tokens;
+	}
+
+private:
+	/** Tokens currently in the bucket. */
+	float Tokens = 0.f;
+
+	/** Time of the last refill. Negative if the bucket has never been refilled. */
+	double LastRefillTime = -1.0;
+};
+
+/**
+ * Server side limiter for client inventory requests.
+ * Keeps one token bucket per client connection, shared between all inventories owned by that connection,
+ * so spreading requests across several inventories doesn't get around the limit.
+ */
+class ITEMIZATIONCORERUNTIME_API FInventoryRequestLimiter
+{
+public:
+	/** Minimum time between two warnings about dropped requests of the same connection. */
+	static constexpr double DroppedRequestsWarningInterval = 10.0;
+
+	/** Returns the global request limiter. Must only be used on the game thread. */
+	static FInventoryRequestLimiter& Get();
+
+	/** Returns the configured cost of a single request of the given type. */
+	static float GetRequestCost(EInventoryRequestType Type);
+
+	/** Returns the bucket of the given connection, refilled up to the current time. */
+	FInventoryRequestTokenBucket& GetConnectionBucket(const UNetConnection* Connection, double CurrentTime);
+
+	/**
+	 * Records that requests of the given connection have been dropped.
+	 * Returns true at most once per DroppedRequestsWarningInterval and connection, so spamming clients can't flood the log.
+	 * @param OutNumDroppedSinceWarning	Number of requests dropped since the last time this returned true, including these.
+	 */
+	bool RecordDroppedRequests(const UNetConnection* Connection, int32 NumDropped, double CurrentTime, uint64& OutNumDroppedSinceWarning);
+
+	/** Returns the number of requests dropped for the given connection. */
+	uint64 GetNumDroppedRequests(const UNetConnection* Connection) const;
+
+	/** Returns the number of requests dropped for all connections. */
+	uint64 GetTotalNumDroppedRequests() const
+	{
+		return TotalNumDroppedRequests;
+	}
+
+private:
+	/** Removes the state of connections that have been closed. */
+	void RemoveStaleConnections();
+
+	struct FConnectionState
+	{
+		/** Token bucket of the connection. */
+		FInventoryRequestTokenBucket Bucket;
+
+		/** Number of requests dropped for this connection. */
+		uint64 NumDroppedRequests = 0;
+
+		/** Number of requests dropped since the last warning. */
+		uint64 NumDroppedSinceWarning = 0;
+
+		/** Time of the last warning about dropped requests. */
+		double LastWarningTime = -DroppedRequestsWarningInterval;
+	};
+
+	/** Per connection state. */
+	TMap<TObjectKey<UNetConnection>, FConnectionState> Connections;
+
+	/** Number of requests dropped for all connections, including closed ones. */
+	uint64 TotalNumDroppedRequests = 0;
+};
\ No newline at end of file